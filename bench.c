@@ -0,0 +1,980 @@
+/*
+ *     bench.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This program times the building blocks of unblackedges on
+ *     synthetic bitmaps made by pbmGenerate: Bit2_get and Bit2_put (checked
+ *     and unchecked), both Bit2 map orders on both Bit2 layouts, the Bit2
+ *     row map, UArray2_at (checked and unchecked), the UArray2 and UArray2b
+ *     maps, pbmRead and pbmReadMapped, pbmWrite, every clearing engine on
+ *     every bitmap of the corpus, and sudokuCheckBoard on batches of valid
+ *     9 x 9, 16 x 16 and 25 x 25 sudokus. Each benchmark is run a number
+ *     of times and its best and mean times are written as one JSON object
+ *     per line to the results file, so runs made before and after a change
+ *     can be compared by a script. Every engine must leave exactly the bitmap the
+ *     dfs engine leaves, bit for bit, and every sudoku must be found valid,
+ *     or the program fails.
+ *     usage: bench [-o results] [-n reps] [-s scale]
+ */
+
+/* clock_gettime is POSIX, not part of c99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <time.h>
+#include <mem.h>
+#include <bit2.h>
+#include <uarray2.h>
+#include <uarray2b.h>
+#include <frontier.h>
+#include <pool.h>
+#include <pbmReadWrite.h>
+#include <clearEngine.h>
+#include <pbmGen.h>
+#include <sudokuCheck.h>
+
+/**********struct BenchImage********
+ * About: This struct describes one bitmap of the benchmark corpus
+************************/
+typedef struct BenchImage {
+        const char *name; /* the name used in the results */
+        PbmGenKind kind; /* the kind of bitmap */
+        int width; /* the number of cols before scaling */
+        int height; /* the number of rows before scaling */
+        double density; /* the chance of a bit being black */
+} BenchImage;
+
+/* the corpus: frames, a spiral maze, noise around the percolation density
+ * of 0.59 and very wide and very tall pages */
+static const BenchImage benchCorpus[] = {
+        { "frame", PBMGEN_FRAME, 2048, 2048, 0.5 },
+        { "spiral", PBMGEN_SPIRAL, 1024, 1024, 0 },
+        { "noise30", PBMGEN_NOISE, 2048, 2048, 0.30 },
+        { "noise59", PBMGEN_NOISE, 2048, 2048, 0.59 },
+        { "noise80", PBMGEN_NOISE, 2048, 2048, 0.80 },
+        { "wide", PBMGEN_NOISE, 262144, 16, 0.59 },
+        { "tall", PBMGEN_NOISE, 16, 262144, 0.59 }
+};
+
+#define BENCH_IMAGES ((int)(sizeof(benchCorpus) / sizeof(benchCorpus[0])))
+
+/* the corpus image the microbenchmarks run on */
+#define BENCH_MICRO_IMAGE 3
+
+/* the sudokus checked by the sudoku benchmark before scaling */
+#define BENCH_SUDOKUS 16384
+
+/* the size of the chunks of the pool the engines take their arrays from */
+#define BENCH_POOL_CHUNK (1 << 20)
+
+/**********struct Bench********
+ * About: This struct holds everything one benchmark needs across its runs
+************************/
+typedef struct Bench {
+        const char *name; /* the name of the benchmark */
+        const char *image; /* the name of the corpus image */
+        int width; /* the number of cols of the image */
+        int height; /* the number of rows of the image */
+        Bit2_T source; /* the generated bitmap, never changed */
+        Bit2_T work; /* a copy of source that a run may change */
+        UArray2_T grid; /* an int array of the size of source */
+        UArray2b_T blockedGrid; /* the same int array stored in blocks */
+        Frontier_T stack; /* the stack of the engines */
+        Pool_T pool; /* the arrays of the engines, reset before each run */
+        Engine engine; /* the engine of a clearing benchmark */
+        FILE *file; /* the encoded source for the read benchmarks */
+        unsigned char *data; /* the bytes of file for pbmReadMapped */
+        size_t length; /* the number of bytes of data */
+        FILE *sink; /* where the write benchmarks write to */
+        int format; /* the pbm format being read or written */
+        unsigned char *cells; /* the sudokus, one after another */
+        int box; /* the side of a box of the sudokus */
+        int boards; /* the number of sudokus in cells */
+} Bench;
+
+/* one run of a benchmark; it returns the seconds spent in the timed part
+ * and stores a result that depends on all the work done */
+typedef double BenchRun(Bench *bench, long *result);
+
+/* function declarations */
+double benchNow(void);
+void benchCopy(Bit2_T to, Bit2_T from);
+bool benchSame(Bit2_T bitmap1, Bit2_T bitmap2);
+long benchCount(Bit2_T bitmap);
+Bit2_T benchBlocked(Bench *bench);
+void benchEncode(Bench *bench, int format);
+void benchSudokus(Bench *bench, int box, int boards);
+long benchMeasure(FILE *results, Bench *bench, BenchRun run, int reps,
+                  long ops);
+void countApply(int col, int row, Bit2_T array, int bit, void *p1);
+void sumApply(int col, int row, UArray2_T array, void *p1, void *p2);
+void sumBlockedApply(int col, int row, UArray2b_T array, void *p1, void *p2);
+void countRowApply(int row, Bit2_word *span, int words, Bit2_T array,
+                   void *p1);
+double runBit2Get(Bench *bench, long *result);
+double runBit2Put(Bench *bench, long *result);
+double runBit2GetUnchecked(Bench *bench, long *result);
+double runBit2PutUnchecked(Bench *bench, long *result);
+double runMapRowMajor(Bench *bench, long *result);
+double runMapColMajor(Bench *bench, long *result);
+double runMapRows(Bench *bench, long *result);
+double runUArray2At(Bench *bench, long *result);
+double runUArray2AtUnchecked(Bench *bench, long *result);
+double runUArray2ColMajor(Bench *bench, long *result);
+double runUArray2bColMajor(Bench *bench, long *result);
+double runUArray2bMap(Bench *bench, long *result);
+double runRead(Bench *bench, long *result);
+double runReadMapped(Bench *bench, long *result);
+double runWrite(Bench *bench, long *result);
+double runClear(Bench *bench, long *result);
+double runClearBlocked(Bench *bench, long *result);
+double runSudoku(Bench *bench, long *result);
+
+/**********main********
+ *
+ * About: Reads the options, generates the corpus and runs every benchmark.
+ *        The -o option names the results file (bench_results.json by
+ *        default), -n sets the number of runs of each benchmark (5 by
+ *        default) and -s divides the sides of every corpus bitmap by the
+ *        given scale for a quicker run.
+ * Inputs:
+ * int argc: number of given arguments to start the program
+ * char *argv: an array that stores the arguments
+ * Return: EXIT_SUCCESS if every engine left the same bitmap behind,
+ *         EXIT_FAILURE otherwise or on bad arguments
+ ************************/
+int main(int argc, char *argv[]) {
+        const char *resultsName = "bench_results.json";
+        int reps = 5;
+        int scale = 1;
+
+        for (int i = 1; i < argc; i++) {
+                if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+                        resultsName = argv[++i];
+                }
+                else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc &&
+                         atoi(argv[i + 1]) > 0) {
+                        reps = atoi(argv[++i]);
+                }
+                else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc &&
+                         atoi(argv[i + 1]) > 0) {
+                        scale = atoi(argv[++i]);
+                }
+                else {
+                        fprintf(stderr, "usage: %s [-o results] [-n reps] "
+                                "[-s scale]\n", argv[0]);
+                        return EXIT_FAILURE;
+                }
+        }
+
+        FILE *results = fopen(resultsName, "w");
+        FILE *sink = fopen("/dev/null", "w");
+        if (results == NULL || sink == NULL) {
+                fprintf(stderr, "%s: cannot open %s or /dev/null\n", argv[0],
+                        resultsName);
+                return EXIT_FAILURE;
+        }
+        bool agree = true;
+
+        for (int i = 0; i < BENCH_IMAGES; i++) {
+                const BenchImage *image = &benchCorpus[i];
+                int width = image->width / scale > 0 ?
+                            image->width / scale : 1;
+                int height = image->height / scale > 0 ?
+                             image->height / scale : 1;
+
+                Bench bench;
+                memset(&bench, 0, sizeof(bench));
+                bench.image = image->name;
+                bench.width = width;
+                bench.height = height;
+                bench.source = pbmGenerate(image->kind, width, height,
+                                           image->density, i + 1);
+                bench.work = Bit2_new(width, height);
+                bench.stack = Frontier_new(100);
+                bench.pool = Pool_new(BENCH_POOL_CHUNK);
+                if (bench.pool == NULL) {
+                        fprintf(stderr, "%s: out of memory\n", argv[0]);
+                        return EXIT_FAILURE;
+                }
+                bench.sink = sink;
+                long bits = (long)width * height;
+
+                if (i == BENCH_MICRO_IMAGE) {
+                        bench.grid = UArray2_new(width, height, sizeof(int));
+                        bench.name = "bit2_get";
+                        benchMeasure(results, &bench, runBit2Get, reps, bits);
+                        bench.name = "bit2_put";
+                        benchMeasure(results, &bench, runBit2Put, reps, bits);
+                        bench.name = "bit2_get_unchecked";
+                        benchMeasure(results, &bench, runBit2GetUnchecked,
+                                     reps, bits);
+                        bench.name = "bit2_put_unchecked";
+                        benchMeasure(results, &bench, runBit2PutUnchecked,
+                                     reps, bits);
+                        bench.name = "bit2_map_row_major";
+                        benchMeasure(results, &bench, runMapRowMajor, reps,
+                                     bits);
+                        bench.name = "bit2_map_col_major";
+                        benchMeasure(results, &bench, runMapColMajor, reps,
+                                     bits);
+                        bench.name = "bit2_map_rows";
+                        benchMeasure(results, &bench, runMapRows, reps, bits);
+                        Bit2_T rows = bench.source;
+                        bench.source = benchBlocked(&bench);
+                        bench.name = "bit2_get_blocked";
+                        benchMeasure(results, &bench, runBit2Get, reps, bits);
+                        bench.name = "bit2_map_row_major_blocked";
+                        benchMeasure(results, &bench, runMapRowMajor, reps,
+                                     bits);
+                        bench.name = "bit2_map_col_major_blocked";
+                        benchMeasure(results, &bench, runMapColMajor, reps,
+                                     bits);
+                        Bit2_free(&bench.source);
+                        bench.source = rows;
+                        bench.name = "uarray2_at";
+                        benchMeasure(results, &bench, runUArray2At, reps,
+                                     bits);
+                        bench.name = "uarray2_at_unchecked";
+                        benchMeasure(results, &bench, runUArray2AtUnchecked,
+                                     reps, bits);
+                        bench.blockedGrid = UArray2b_new_64K_block(width,
+                                            height, sizeof(int));
+                        bench.name = "uarray2_map_col_major";
+                        benchMeasure(results, &bench, runUArray2ColMajor,
+                                     reps, bits);
+                        bench.name = "uarray2b_map_col_major";
+                        benchMeasure(results, &bench, runUArray2bColMajor,
+                                     reps, bits);
+                        bench.name = "uarray2b_map";
+                        benchMeasure(results, &bench, runUArray2bMap, reps,
+                                     bits);
+                        UArray2b_free(&bench.blockedGrid);
+                        UArray2_free(&bench.grid);
+
+                        for (int f = 0; f < 2; f++) {
+                                bool plain = f == 0;
+                                benchEncode(&bench, plain ? PBM_PLAIN :
+                                                    PBM_RAW);
+                                bench.name = plain ? "pbm_read_p1" :
+                                             "pbm_read_p4";
+                                benchMeasure(results, &bench, runRead, reps,
+                                             bits);
+                                bench.name = plain ? "pbm_read_mapped_p1" :
+                                             "pbm_read_mapped_p4";
+                                benchMeasure(results, &bench, runReadMapped,
+                                             reps, bits);
+                                bench.name = plain ? "pbm_write_p1" :
+                                             "pbm_write_p4";
+                                benchMeasure(results, &bench, runWrite, reps,
+                                             bits);
+                                fclose(bench.file);
+                                FREE(bench.data);
+                        }
+                }
+
+                /* every engine must leave exactly the bitmap dfs leaves */
+                Bit2_T expected = Bit2_new(width, height);
+                long expectedBlack = 0;
+                char name[32];
+                for (int e = 0; e < ENGINE_COUNT; e++) {
+                        bench.engine = (Engine)e;
+                        snprintf(name, sizeof(name), "clear_%s",
+                                 engineName(bench.engine));
+                        bench.name = name;
+                        long black = benchMeasure(results, &bench, runClear,
+                                                  reps, bits);
+                        if (black < 0) {
+                                fprintf(stderr, "%s: engine %s ran out of "
+                                        "memory on %s\n", argv[0],
+                                        engineName(bench.engine),
+                                        image->name);
+                                agree = false;
+                        }
+                        else if (bench.engine == ENGINE_DFS) {
+                                benchCopy(expected, bench.work);
+                                expectedBlack = black;
+                        }
+                        else if (!benchSame(bench.work, expected)) {
+                                fprintf(stderr, "%s: engine %s left %ld "
+                                        "black bits on %s, not the %ld the "
+                                        "dfs engine left\n", argv[0],
+                                        engineName(bench.engine), black,
+                                        image->name, expectedBlack);
+                                agree = false;
+                        }
+                }
+                Bit2_free(&expected);
+                bench.name = "clear_dfs_blocked";
+                long black = benchMeasure(results, &bench, runClearBlocked,
+                                          reps, bits);
+                if (black != expectedBlack) {
+                        fprintf(stderr, "%s: blocked dfs left %ld black bits "
+                                "on %s, expected %ld\n", argv[0], black,
+                                image->name, expectedBlack);
+                        agree = false;
+                }
+
+                Frontier_free(&bench.stack);
+                Pool_free(&bench.pool);
+                Bit2_free(&bench.work);
+                Bit2_free(&bench.source);
+        }
+
+        /* the sudoku checker on growing sides, the cells being the ops */
+        int boards = BENCH_SUDOKUS / scale > 0 ? BENCH_SUDOKUS / scale : 1;
+        for (int box = 3; box <= 5; box++) {
+                Bench bench;
+                memset(&bench, 0, sizeof(bench));
+                char image[32];
+                snprintf(image, sizeof(image), "sudoku%d", box * box);
+                bench.name = "sudoku_check";
+                bench.image = image;
+                bench.width = box * box;
+                bench.height = box * box;
+                benchSudokus(&bench, box, boards);
+
+                long valid = benchMeasure(results, &bench, runSudoku, reps,
+                                          (long)boards * box * box * box *
+                                          box);
+                if (valid != boards) {
+                        fprintf(stderr, "%s: only %ld of %d valid %d x %d "
+                                "sudokus were found valid\n", argv[0],
+                                valid, boards, box * box, box * box);
+                        agree = false;
+                }
+                FREE(bench.cells);
+        }
+
+        fclose(sink);
+        fclose(results);
+        return agree ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**********benchNow********
+ * About: This function reads a monotonic clock
+ * Return: the time in seconds from an arbitrary start
+************************/
+double benchNow(void) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/**********benchCopy********
+ * About: This function copies the bits of a bitmap into another bitmap of
+ * the same size, a row span at a time
+ * Inputs:
+ * Bit2_T to: the bitmap being written
+ * Bit2_T from: the bitmap being copied
+ * Return: none
+************************/
+void benchCopy(Bit2_T to, Bit2_T from) {
+        size_t bytes = Bit2_row_words(from) * sizeof(Bit2_word);
+        for (int row = 0; row < Bit2_height(from); row++) {
+                memcpy(Bit2_row_mut(to, row), Bit2_row(from, row), bytes);
+        }
+}
+
+/**********benchSame********
+ * About: This function compares two bitmaps of the same size stored in
+ * rows, a row span at a time. Padding bits are always white, so whole
+ * words can be compared.
+ * Inputs:
+ * Bit2_T bitmap1: the first bitmap
+ * Bit2_T bitmap2: the second bitmap
+ * Return: true if every bit of the two bitmaps is the same
+************************/
+bool benchSame(Bit2_T bitmap1, Bit2_T bitmap2) {
+        size_t bytes = Bit2_row_words(bitmap1) * sizeof(Bit2_word);
+        for (int row = 0; row < Bit2_height(bitmap1); row++) {
+                if (memcmp(Bit2_row(bitmap1, row), Bit2_row(bitmap2, row),
+                           bytes) != 0) {
+                        return false;
+                }
+        }
+        return true;
+}
+
+/**********benchCount********
+ * About: This function counts the black bits of a bitmap
+ * Inputs:
+ * Bit2_T bitmap: the bitmap
+ * Return: the number of black bits
+************************/
+long benchCount(Bit2_T bitmap) {
+        long black = 0;
+        if (Bit2_layout(bitmap) == BIT2_BLOCKED) {
+                Bit2_map_row_major(bitmap, countApply, &black);
+                return black;
+        }
+        for (int row = 0; row < Bit2_height(bitmap); row++) {
+                const Bit2_word *span = Bit2_row(bitmap, row);
+                for (int w = 0; w < Bit2_row_words(bitmap); w++) {
+                        black += __builtin_popcountll(span[w]);
+                }
+        }
+        return black;
+}
+
+/**********benchBlocked********
+ * About: This function makes a copy of the source bitmap of a benchmark
+ * stored in 8x8 blocks
+ * Inputs:
+ * Bench *bench: the benchmark
+ * Return: the copy, which the caller frees with Bit2_free
+************************/
+Bit2_T benchBlocked(Bench *bench) {
+        return Bit2_copy_layout(bench->source, BIT2_BLOCKED);
+}
+
+/**********benchEncode********
+ * About: This function writes the source bitmap of a benchmark to a
+ * temporary file in the given format and keeps a copy of its bytes in
+ * memory for pbmReadMapped
+ * Inputs:
+ * Bench *bench: the benchmark
+ * int format: PBM_PLAIN or PBM_RAW
+ * Return: none
+************************/
+void benchEncode(Bench *bench, int format) {
+        bench->format = format;
+        bench->file = tmpfile();
+        assert(bench->file != NULL);
+        pbmWrite(bench->file, bench->source, format);
+
+        bench->length = ftell(bench->file);
+        bench->data = ALLOC(bench->length);
+        rewind(bench->file);
+        size_t read = fread(bench->data, 1, bench->length, bench->file);
+        assert(read == bench->length);
+        (void)read;
+}
+
+/**********benchSudokus********
+ * About: This function fills the benchmark with valid sudokus. Board i holds
+ * the classic pattern of shifted rows with every value moved up by i, so
+ * the boards differ while staying valid.
+ * Inputs:
+ * Bench *bench: the benchmark, which gets its cells, box and boards set
+ * int box: the side of a box of the sudokus
+ * int boards: the number of sudokus
+ * Return: none
+************************/
+void benchSudokus(Bench *bench, int box, int boards) {
+        int side = box * box;
+        bench->box = box;
+        bench->boards = boards;
+        bench->cells = ALLOC((long)boards * side * side);
+
+        unsigned char *cell = bench->cells;
+        for (int i = 0; i < boards; i++) {
+                for (int row = 0; row < side; row++) {
+                        for (int col = 0; col < side; col++) {
+                                *cell++ = (row * box + row / box + col + i) %
+                                          side + 1;
+                        }
+                }
+        }
+}
+
+/**********benchMeasure********
+ * About: This function runs a benchmark reps times, then prints its best
+ * and mean times as a line of JSON to the results file and as a line of
+ * text to stdout
+ * Inputs:
+ * FILE *results: the results file
+ * Bench *bench: the benchmark
+ * BenchRun run: one run of the benchmark
+ * int reps: the number of runs
+ * long ops: the number of operations (bits, or cells of the sudokus)
+ *           handled by one run
+ * Return: the result of the last run
+************************/
+long benchMeasure(FILE *results, Bench *bench, BenchRun run, int reps,
+                  long ops) {
+        double best = 0, total = 0;
+        long result = 0;
+
+        for (int i = 0; i < reps; i++) {
+                double seconds = run(bench, &result);
+                if (i == 0 || seconds < best) {
+                        best = seconds;
+                }
+                total += seconds;
+        }
+
+        fprintf(results, "{\"bench\": \"%s\", \"image\": \"%s\", "
+                "\"width\": %d, \"height\": %d, \"reps\": %d, "
+                "\"best_s\": %.9f, \"mean_s\": %.9f, \"ns_per_bit\": %.4f, "
+                "\"result\": %ld}\n", bench->name, bench->image,
+                bench->width, bench->height, reps,
+                best, total / reps, best * 1e9 / ops, result);
+        printf("%-20s %-8s %10.3f ms %8.3f ns/bit\n", bench->name,
+               bench->image, best * 1e3, best * 1e9 / ops);
+        fflush(stdout);
+        return result;
+}
+
+/**********countApply********
+ * About: This function is a map apply function that counts black bits
+ * Inputs:
+ * int col, int row: the location of the bit
+ * Bit2_T array: the bitmap being mapped
+ * int bit: the value of the bit
+ * void *p1: pointer to the long count
+ * Return: none
+************************/
+void countApply(int col, int row, Bit2_T array, int bit, void *p1) {
+        (void)col;
+        (void)row;
+        (void)array;
+        *(long *)p1 += bit;
+}
+
+/**********sumApply********
+ * About: This function is a UArray2 map apply function that sums the int
+ * elements
+ * Inputs:
+ * int col, int row: the location of the element
+ * UArray2_T array: the array being mapped
+ * void *p1: pointer to the element
+ * void *p2: pointer to the long sum
+ * Return: none
+************************/
+void sumApply(int col, int row, UArray2_T array, void *p1, void *p2) {
+        (void)col;
+        (void)row;
+        (void)array;
+        *(long *)p2 += *(int *)p1;
+}
+
+/**********sumBlockedApply********
+ * About: This function is a UArray2b map apply function that sums the int
+ * elements
+ * Inputs:
+ * int col, int row: the location of the element
+ * UArray2b_T array: the array being mapped
+ * void *p1: pointer to the element
+ * void *p2: pointer to the long sum
+ * Return: none
+************************/
+void sumBlockedApply(int col, int row, UArray2b_T array, void *p1, void *p2) {
+        (void)col;
+        (void)row;
+        (void)array;
+        *(long *)p2 += *(int *)p1;
+}
+
+/**********countRowApply********
+ * About: This function is a Bit2_map_rows apply function that counts black
+ * bits a word at a time
+ * Inputs:
+ * int row: the index of the row
+ * Bit2_word *span: the words of the row
+ * int words: the number of words in span
+ * Bit2_T array: the bitmap being mapped
+ * void *p1: pointer to the long count
+ * Return: none
+************************/
+void sumApply(int col, int row, UArray2_T array, void *p1, void *p2);
+void sumBlockedApply(int col, int row, UArray2b_T array, void *p1, void *p2);
+void countRowApply(int row, Bit2_word *span, int words, Bit2_T array,
+                   void *p1) {
+        (void)row;
+        (void)array;
+        for (int w = 0; w < words; w++) {
+                *(long *)p1 += __builtin_popcountll(span[w]);
+        }
+}
+
+/**********runBit2Get********
+ * About: This function reads every bit of the source with Bit2_get
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits
+ * Return: the seconds spent
+************************/
+double runBit2Get(Bench *bench, long *result) {
+        int width = Bit2_width(bench->source);
+        int height = Bit2_height(bench->source);
+        long black = 0;
+
+        double start = benchNow();
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        black += Bit2_get(bench->source, col, row);
+                }
+        }
+        double seconds = benchNow() - start;
+
+        *result = black;
+        return seconds;
+}
+
+/**********runBit2Put********
+ * About: This function writes every bit of the work bitmap with Bit2_put,
+ * making a checkerboard
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits written
+ * Return: the seconds spent
+************************/
+double runBit2Put(Bench *bench, long *result) {
+        int width = Bit2_width(bench->work);
+        int height = Bit2_height(bench->work);
+
+        double start = benchNow();
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        Bit2_put(bench->work, col, row, (col ^ row) & 1);
+                }
+        }
+        double seconds = benchNow() - start;
+
+        *result = benchCount(bench->work);
+        return seconds;
+}
+
+/**********runBit2GetUnchecked********
+ * About: This function reads every bit of the source with
+ * Bit2_get_unchecked
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits
+ * Return: the seconds spent
+************************/
+double runBit2GetUnchecked(Bench *bench, long *result) {
+        int width = Bit2_width(bench->source);
+        int height = Bit2_height(bench->source);
+        long black = 0;
+
+        double start = benchNow();
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        black += Bit2_get_unchecked(bench->source, col, row);
+                }
+        }
+        double seconds = benchNow() - start;
+
+        *result = black;
+        return seconds;
+}
+
+/**********runBit2PutUnchecked********
+ * About: This function writes every bit of the work bitmap with
+ * Bit2_put_unchecked, making a checkerboard
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits written
+ * Return: the seconds spent
+************************/
+double runBit2PutUnchecked(Bench *bench, long *result) {
+        int width = Bit2_width(bench->work);
+        int height = Bit2_height(bench->work);
+
+        double start = benchNow();
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        Bit2_put_unchecked(bench->work, col, row,
+                                           (col ^ row) & 1);
+                }
+        }
+        double seconds = benchNow() - start;
+
+        *result = benchCount(bench->work);
+        return seconds;
+}
+
+/**********runMapRowMajor********
+ * About: This function counts the black bits of the source with
+ * Bit2_map_row_major
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits
+ * Return: the seconds spent
+************************/
+double runMapRowMajor(Bench *bench, long *result) {
+        long black = 0;
+        double start = benchNow();
+        Bit2_map_row_major(bench->source, countApply, &black);
+        double seconds = benchNow() - start;
+
+        *result = black;
+        return seconds;
+}
+
+/**********runMapColMajor********
+ * About: This function counts the black bits of the source with
+ * Bit2_map_col_major
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits
+ * Return: the seconds spent
+************************/
+double runMapColMajor(Bench *bench, long *result) {
+        long black = 0;
+        double start = benchNow();
+        Bit2_map_col_major(bench->source, countApply, &black);
+        double seconds = benchNow() - start;
+
+        *result = black;
+        return seconds;
+}
+
+/**********runMapRows********
+ * About: This function counts the black bits of the source with
+ * Bit2_map_rows
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits
+ * Return: the seconds spent
+************************/
+double runMapRows(Bench *bench, long *result) {
+        long black = 0;
+        double start = benchNow();
+        Bit2_map_rows(bench->source, countRowApply, &black);
+        double seconds = benchNow() - start;
+
+        *result = black;
+        return seconds;
+}
+
+/**********runUArray2At********
+ * About: This function writes and then reads back every element of an int
+ * UArray2_T of the size of the source with UArray2_at
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the sum of the elements read
+ * Return: the seconds spent
+************************/
+double runUArray2At(Bench *bench, long *result) {
+        int width = UArray2_width(bench->grid);
+        int height = UArray2_height(bench->grid);
+        long sum = 0;
+
+        double start = benchNow();
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        *(int *)UArray2_at(bench->grid, col, row) = col ^ row;
+                }
+        }
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        sum += *(int *)UArray2_at(bench->grid, col, row);
+                }
+        }
+        double seconds = benchNow() - start;
+
+        *result = sum;
+        return seconds;
+}
+
+/**********runUArray2AtUnchecked********
+ * About: This function writes and then reads back every element of an int
+ * UArray2_T of the size of the source with UArray2_at_unchecked
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the sum of the elements read
+ * Return: the seconds spent
+************************/
+double runUArray2AtUnchecked(Bench *bench, long *result) {
+        int width = UArray2_width(bench->grid);
+        int height = UArray2_height(bench->grid);
+        long sum = 0;
+
+        double start = benchNow();
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        *(int *)UArray2_at_unchecked(bench->grid, col, row) =
+                                col ^ row;
+                }
+        }
+        for (int row = 0; row < height; row++) {
+                for (int col = 0; col < width; col++) {
+                        sum += *(int *)UArray2_at_unchecked(bench->grid, col,
+                                                            row);
+                }
+        }
+        double seconds = benchNow() - start;
+
+        *result = sum;
+        return seconds;
+}
+
+/**********runUArray2ColMajor********
+ * About: This function sums the elements of the int UArray2_T with
+ * UArray2_map_col_major
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the sum of the elements
+ * Return: the seconds spent
+************************/
+double runUArray2ColMajor(Bench *bench, long *result) {
+        long sum = 0;
+        double start = benchNow();
+        UArray2_map_col_major(bench->grid, sumApply, &sum);
+        double seconds = benchNow() - start;
+
+        *result = sum;
+        return seconds;
+}
+
+/**********runUArray2bColMajor********
+ * About: This function sums the elements of the int UArray2b_T with
+ * UArray2b_map_col_major
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the sum of the elements
+ * Return: the seconds spent
+************************/
+double runUArray2bColMajor(Bench *bench, long *result) {
+        long sum = 0;
+        double start = benchNow();
+        UArray2b_map_col_major(bench->blockedGrid, sumBlockedApply, &sum);
+        double seconds = benchNow() - start;
+
+        *result = sum;
+        return seconds;
+}
+
+/**********runUArray2bMap********
+ * About: This function sums the elements of the int UArray2b_T with the
+ * block major UArray2b_map
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the sum of the elements
+ * Return: the seconds spent
+************************/
+double runUArray2bMap(Bench *bench, long *result) {
+        long sum = 0;
+        double start = benchNow();
+        UArray2b_map(bench->blockedGrid, sumBlockedApply, &sum);
+        double seconds = benchNow() - start;
+
+        *result = sum;
+        return seconds;
+}
+
+/**********runRead********
+ * About: This function reads the encoded source back with pbmRead
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits read
+ * Return: the seconds spent
+************************/
+double runRead(Bench *bench, long *result) {
+        rewind(bench->file);
+        double start = benchNow();
+        Bit2_T bitmap = pbmRead(bench->file);
+        double seconds = benchNow() - start;
+
+        *result = benchCount(bitmap);
+        Bit2_free(&bitmap);
+        return seconds;
+}
+
+/**********runReadMapped********
+ * About: This function reads the encoded source back from memory with
+ * pbmReadMapped
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits read
+ * Return: the seconds spent
+************************/
+double runReadMapped(Bench *bench, long *result) {
+        double start = benchNow();
+        Bit2_T bitmap = pbmReadMapped(bench->data, bench->length);
+        double seconds = benchNow() - start;
+
+        *result = benchCount(bitmap);
+        Bit2_free(&bitmap);
+        return seconds;
+}
+
+/**********runWrite********
+ * About: This function writes the source with pbmWrite to the sink
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of bytes of the encoded source
+ * Return: the seconds spent
+************************/
+double runWrite(Bench *bench, long *result) {
+        double start = benchNow();
+        pbmWrite(bench->sink, bench->source, bench->format);
+        fflush(bench->sink);
+        double seconds = benchNow() - start;
+
+        *result = (long)bench->length;
+        return seconds;
+}
+
+/**********runClear********
+ * About: This function clears the black edges of a fresh copy of the
+ * source with the engine of the benchmark. Only the clearing is timed.
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits left after clearing, or -1 if
+ *              the engine ran out of memory
+ * Return: the seconds spent
+************************/
+double runClear(Bench *bench, long *result) {
+        benchCopy(bench->work, bench->source);
+        Pool_reset(bench->pool);
+        double start = benchNow();
+        bool cleared = engineClearEdges(bench->engine, bench->work,
+                                        bench->stack, bench->pool, 0);
+        double seconds = benchNow() - start;
+
+        *result = cleared ? benchCount(bench->work) : -1;
+        return seconds;
+}
+
+/**********runClearBlocked********
+ * About: This function clears the black edges of a copy of the source
+ * stored in 8x8 blocks with the dfs engine. Only the clearing is timed.
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of black bits left after clearing
+ * Return: the seconds spent
+************************/
+double runClearBlocked(Bench *bench, long *result) {
+        Bit2_T blocked = benchBlocked(bench);
+        Pool_reset(bench->pool);
+        double start = benchNow();
+        engineClearEdges(ENGINE_DFS, blocked, bench->stack, bench->pool, 0);
+        double seconds = benchNow() - start;
+
+        *result = benchCount(blocked);
+        Bit2_free(&blocked);
+        return seconds;
+}
+
+/**********runSudoku********
+ * About: This function checks every sudoku of the benchmark with
+ * sudokuCheckBoard
+ * Inputs:
+ * Bench *bench: the benchmark
+ * long *result: the number of valid sudokus
+ * Return: the seconds spent
+************************/
+double runSudoku(Bench *bench, long *result) {
+        long cells = (long)bench->box * bench->box * bench->box * bench->box;
+        long valid = 0;
+
+        double start = benchNow();
+        for (int i = 0; i < bench->boards; i++) {
+                valid += sudokuCheckBoard(bench->cells + i * cells,
+                                          bench->box);
+        }
+        double seconds = benchNow() - start;
+
+        *result = valid;
+        return seconds;
+}
@@ -7,32 +7,27 @@
  *     can store data in a 2D bit vector. It also has functions that helps the
  *     client to get the width, height, and element size information about the 
  *     vector, traverse the vector in row major and column major order, access
- *     to an element at a certain location, and free the bit vector.
+ *     to an element at a certain location, and free the bit vector. The bits
+ *     are stored either as word aligned rows or as 8x8 blocks of one word
+ *     each. The words of a vector not made from a pool come from calloc, so
+ *     that Bit2_reshape can report running out of memory instead of raising
+ *     Mem_Failed.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <mem.h>
 #include <bit2.h>
-#include <bit.h>
 #include <except.h>
 
 #define T2 Bit2_T
 
-/**********struct T2********
- * About: This struct holds a Bit vector instance that represents a 2D vector 
- *        and the row and column for that vector.
-************************/
-struct T2 {
-        int rows; /* number of rows in in the 2D vector, at least 1 */
-        int cols; /* number of cols in in the 2D vector, at least 1 */
-        Bit_T data; /* Bit_T representing the 2D vector*/
-};
-
 /**********Bit2_new********
  * About: This function initializes a T2 struct and assigns the given values
- *        such as row and col to the struct variables.
+ *        such as row and col to the struct variables. Every row is padded
+ *        to a whole number of words so each row starts word aligned.
  * Inputs:
  * int row: integer value that represents number of rows in the 2D vector that 
  *          the T2 struct holds
@@ -45,26 +40,183 @@ struct T2 {
  * - that it returns a non-null T2 struct
 ************************/
 T2 Bit2_new(int col, int row) {
+        return Bit2_new_layout(col, row, BIT2_ROWS);
+}
+
+/**********Bit2_new_layout********
+ * About: This function initializes a T2 struct like Bit2_new, storing the
+ *        bits in the given layout. With BIT2_BLOCKED the width and height
+ *        are padded to whole 8x8 blocks.
+ * Inputs:
+ * int col: number of columns in the 2D vector
+ * int row: number of rows in the 2D vector
+ * Bit2_Layout layout: BIT2_ROWS or BIT2_BLOCKED
+ * Return: a struct holding a 2D Bit vector with every bit set to 0
+ * Expects
+ * - row and col to be greater than 0
+ * - layout to be BIT2_ROWS or BIT2_BLOCKED
+************************/
+T2 Bit2_new_layout(int col, int row, Bit2_Layout layout) {
+        return Bit2_new_pool(col, row, layout, NULL);
+}
+
+/**********Bit2_new_pool********
+ * About: This function initializes a T2 struct like Bit2_new_layout, taking
+ *        the struct and its words from the given pool. Such a vector is
+ *        freed when the pool is reset or freed; Bit2_free only forgets it.
+ * Inputs:
+ * int col: number of columns in the 2D vector
+ * int row: number of rows in the 2D vector
+ * Bit2_Layout layout: BIT2_ROWS or BIT2_BLOCKED
+ * Pool_T pool: the pool, or NULL to allocate like Bit2_new, which raises
+ *              Mem_Failed when there is not enough memory
+ * Return: a struct holding a 2D Bit vector with every bit set to 0, or NULL
+ *         if the pool ran out of memory
+ * Expects
+ * - row and col to be greater than 0
+ * - layout to be BIT2_ROWS or BIT2_BLOCKED
+************************/
+T2 Bit2_new_pool(int col, int row, Bit2_Layout layout, Pool_T pool) {
         
         /* asserts the expectation for col and row to be > 0 */
         assert(col > 0 && row > 0);
+        assert(layout == BIT2_ROWS || layout == BIT2_BLOCKED);
 
-        /* creating an instance of the struct T2 in malloc */
+        /* creating an instance of the struct T2 in malloc or the pool */
         T2 vector2D;
-        NEW(vector2D);
-        assert(vector2D != NULL);
+        if (pool != NULL) {
+                vector2D = Pool_alloc(pool, (long)sizeof(*vector2D));
+                if (vector2D == NULL) {
+                        return NULL;
+                }
+        }
+        else {
+                NEW(vector2D);
+        }
+        vector2D->pool = pool;
 
         /* initializing the attributes of vector2D */
         vector2D->rows = row;
         vector2D->cols = col;
+        vector2D->layout = layout;
+        long wordRows = row;
+        if (layout == BIT2_BLOCKED) {
+                vector2D->stride = (col + BIT2_BLOCK_SIDE - 1) /
+                                   BIT2_BLOCK_SIDE;
+                wordRows = (row + BIT2_BLOCK_SIDE - 1) / BIT2_BLOCK_SIDE;
+        }
+        else {
+                vector2D->stride = (col + BIT2_WORD_BITS - 1) /
+                                   BIT2_WORD_BITS;
+        }
 
-        /* creating the array */
-        vector2D->data = Bit_new(row * col);
-        assert(vector2D->data != NULL);
-
+        /* creating the array with every bit (padding included) set to 0 */
+        vector2D->capacity = wordRows * vector2D->stride;
+        if (pool != NULL) {
+                vector2D->words = Pool_calloc(pool, vector2D->capacity,
+                                              (long)sizeof(Bit2_word));
+                return vector2D->words != NULL ? vector2D : NULL;
+        }
+        vector2D->words = calloc(vector2D->capacity, sizeof(Bit2_word));
+        if (vector2D->words == NULL) {
+                FREE(vector2D);
+                RAISE(Mem_Failed);
+        }
         return vector2D;
 }
 
+/**********Bit2_copy_layout********
+ * About: This function makes a new 2D vector holding the same bits as the
+ *        given one, stored in the given layout
+ * Inputs:
+ * T2 array: the 2D vector to copy
+ * Bit2_Layout layout: the layout of the copy
+ * Return: the copy, which the client frees with Bit2_free
+ * Expects
+ * - that array is non-null
+************************/
+T2 Bit2_copy_layout(T2 array, Bit2_Layout layout) {
+        assert(array != NULL);
+        T2 copy = Bit2_new_layout(array->cols, array->rows, layout);
+
+        /* the same layout holds the same words, padding included */
+        if (layout == array->layout) {
+                memcpy(copy->words, array->words,
+                       copy->capacity * sizeof(Bit2_word));
+                return copy;
+        }
+
+        /* one of the two is stored in rows, which is the span of the row */
+        for (int row = 0; row < array->rows; row++) {
+                if (layout == BIT2_ROWS) {
+                        Bit2_get_row(array, row, Bit2_row_mut(copy, row));
+                }
+                else {
+                        Bit2_put_row(copy, row, Bit2_row(array, row));
+                }
+        }
+        return copy;
+}
+
+/**********Bit2_reshape********
+ * About: This function gives the 2D vector a new width and height, keeping
+ *        its layout and setting every bit to 0. The words already allocated
+ *        are reused when they are enough, so a client reading many images
+ *        into one vector only allocates for the largest of them.
+ * Inputs:
+ * T2 array: the 2D vector to reshape
+ * int col: the new number of columns
+ * int row: the new number of rows
+ * Return: true if the vector was reshaped, false if there was not enough
+ *         memory for the new size, in which case the vector is unchanged
+ * Expects
+ * - that array is non-null and row and col are greater than 0
+************************/
+bool Bit2_reshape(T2 array, int col, int row) {
+        assert(array != NULL);
+        assert(col > 0 && row > 0);
+
+        long wordRows = row;
+        int stride;
+        if (array->layout == BIT2_BLOCKED) {
+                stride = (col + BIT2_BLOCK_SIDE - 1) / BIT2_BLOCK_SIDE;
+                wordRows = (row + BIT2_BLOCK_SIDE - 1) / BIT2_BLOCK_SIDE;
+        }
+        else {
+                stride = (col + BIT2_WORD_BITS - 1) / BIT2_WORD_BITS;
+        }
+
+        /* the vector is only changed once the words are allocated, so it
+           stays whole if there is not enough memory */
+        long length = wordRows * stride;
+        if (length > array->capacity) {
+                /* the old bits are not kept, so no need to copy them */
+                Bit2_word *words;
+                if (array->pool != NULL) {
+                        words = Pool_calloc(array->pool, length,
+                                            (long)sizeof(Bit2_word));
+                }
+                else {
+                        words = calloc(length, sizeof(Bit2_word));
+                }
+                if (words == NULL) {
+                        return false;
+                }
+                if (array->pool == NULL) {
+                        free(array->words);
+                }
+                array->words = words;
+                array->capacity = length;
+        }
+        else {
+                memset(array->words, 0, length * sizeof(Bit2_word));
+        }
+        array->rows = row;
+        array->cols = col;
+        array->stride = stride;
+        return true;
+}
+
 /**********Bit2_width********
  * About: This function returns the width value (col number) of the 2D vector  
  *        that the T2 struct holds
@@ -93,6 +245,19 @@ int Bit2_height(T2 array) {
         return array->rows;
 }
 
+/**********Bit2_layout********
+ * About: This function returns the layout the 2D vector was created with
+ * Inputs: 
+ * T2 array: struct to store the content of the given data in 2D vector
+ * Return: BIT2_ROWS or BIT2_BLOCKED
+ * Expects
+ * - that array is non-null
+************************/
+Bit2_Layout Bit2_layout(T2 array) {
+        assert(array != NULL);
+        return array->layout;
+}
+
 /**********Bit2_put********
  * About: This function updates the value at the given row and column indices 
  *        to be the value provided by the bit variable and returns the previous
@@ -115,7 +280,20 @@ int Bit2_put(T2 array, int col, int row, int bit) {
         
         assert(col >= 0 && col < Bit2_width(array));
         assert(row >= 0 && row < Bit2_height(array));
-        return Bit_put(array->data, row * array->cols + col, bit);
+        assert(bit == 0 || bit == 1);
+
+        int shift;
+        Bit2_word *word = Bit2_word_at(array, col, row, &shift);
+        Bit2_word mask = (Bit2_word)1 << shift;
+        int prev = (*word & mask) != 0;
+
+        if (bit == 1) {
+                *word |= mask;
+        }
+        else {
+                *word &= ~mask;
+        }
+        return prev;
 }
 
 /**********Bit2_get********
@@ -137,7 +315,153 @@ int Bit2_put(T2 array, int col, int row, int bit) {
 int Bit2_get(T2 array, int col, int row) {
         assert(col >= 0 && col < Bit2_width(array));
         assert(row >= 0 && row < Bit2_height(array));
-        return Bit_get(array->data, row * array->cols + col);
+
+        int shift;
+        const Bit2_word *word = Bit2_word_at(array, col, row, &shift);
+        return (*word >> shift) & 1;
+}
+
+/**********Bit2_row_words********
+ * About: This function returns the number of words that hold one row of the
+ *        2D vector, which is the length of the spans returned by Bit2_row
+ *        and Bit2_row_mut
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D vector
+ * Return: the number of words in one row span
+ * Expects
+ * - that array is non-null and stored as BIT2_ROWS
+************************/
+int Bit2_row_words(T2 array) {
+        assert(array != NULL && array->layout == BIT2_ROWS);
+        return array->stride;
+}
+
+/**********Bit2_last_word_mask********
+ * About: This function returns a mask of the bits of the last word of a row
+ *        span that hold real columns. Bits outside of this mask are padding
+ *        and are always 0.
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D vector
+ * Return: the mask of used bits in the last word of every row
+ * Expects
+ * - that array is non-null and stored as BIT2_ROWS
+************************/
+Bit2_word Bit2_last_word_mask(T2 array) {
+        assert(array != NULL && array->layout == BIT2_ROWS);
+        int used = array->cols % BIT2_WORD_BITS;
+        if (used == 0) {
+                return ~(Bit2_word)0;
+        }
+        return ((Bit2_word)1 << used) - 1;
+}
+
+/**********Bit2_row********
+ * About: This function returns a read-only span of the words that hold the
+ *        given row. The span is Bit2_row_words(array) words long.
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D vector
+ * int row: index of the row to access
+ * Return: a pointer to the first word of the row
+ * Expects
+ * - that array is non-null and stored as BIT2_ROWS
+ * - that row is at least 0 and at most Bit2_height(array) - 1
+************************/
+const Bit2_word *Bit2_row(T2 array, int row) {
+        assert(array != NULL && array->layout == BIT2_ROWS);
+        assert(row >= 0 && row < array->rows);
+        return array->words + (long)row * array->stride;
+}
+
+/**********Bit2_row_mut********
+ * About: This function returns a mutable span of the words that hold the
+ *        given row. The span is Bit2_row_words(array) words long.
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D vector
+ * int row: index of the row to access
+ * Return: a pointer to the first word of the row
+ * Expects
+ * - that array is non-null and stored as BIT2_ROWS
+ * - that row is at least 0 and at most Bit2_height(array) - 1
+ * - that the client keeps the padding bits (outside Bit2_last_word_mask in
+ *   the last word) set to 0
+************************/
+Bit2_word *Bit2_row_mut(T2 array, int row) {
+        assert(array != NULL && array->layout == BIT2_ROWS);
+        assert(row >= 0 && row < array->rows);
+        return array->words + (long)row * array->stride;
+}
+
+/**********Bit2_get_row********
+ * About: This function copies a row of the 2D vector into a span, in either
+ *        layout. A row stored in blocks is gathered a byte at a time, as
+ *        the 8 bits of a row in a block are one byte of the block's word.
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D vector
+ * int row: index of the row to copy
+ * Bit2_word *span: the (Bit2_width(array) + 63) / 64 words the row is
+ *                  copied into, with the padding bits set to 0
+ * Return: none
+ * Expects
+ * - that array and span are non-null
+ * - that row is at least 0 and at most Bit2_height(array) - 1
+************************/
+void Bit2_get_row(T2 array, int row, Bit2_word *span) {
+        assert(array != NULL && span != NULL);
+        assert(row >= 0 && row < array->rows);
+        int words = (array->cols + BIT2_WORD_BITS - 1) / BIT2_WORD_BITS;
+
+        if (array->layout == BIT2_ROWS) {
+                memcpy(span, Bit2_row_unchecked(array, row),
+                       words * sizeof(Bit2_word));
+                return;
+        }
+        const Bit2_word *blocks = array->words +
+                                  (long)(row / BIT2_BLOCK_SIDE) * array->stride;
+        int shift = (row % BIT2_BLOCK_SIDE) * BIT2_BLOCK_SIDE;
+        for (int w = 0; w < words; w++) {
+                Bit2_word word = 0;
+                for (int b = 0; b < BIT2_BLOCK_SIDE &&
+                     w * BIT2_BLOCK_SIDE + b < array->stride; b++) {
+                        word |= ((blocks[w * BIT2_BLOCK_SIDE + b] >> shift) &
+                                 0xff) << (BIT2_BLOCK_SIDE * b);
+                }
+                span[w] = word;
+        }
+}
+
+/**********Bit2_put_row********
+ * About: This function copies a span into a row of the 2D vector, in either
+ *        layout. A row stored in blocks is scattered a byte at a time into
+ *        the words of its blocks.
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D vector
+ * int row: index of the row to store
+ * const Bit2_word *span: the (Bit2_width(array) + 63) / 64 words of the row
+ * Return: none
+ * Expects
+ * - that array and span are non-null
+ * - that row is at least 0 and at most Bit2_height(array) - 1
+ * - that the padding bits of span (past the last column) are 0
+************************/
+void Bit2_put_row(T2 array, int row, const Bit2_word *span) {
+        assert(array != NULL && span != NULL);
+        assert(row >= 0 && row < array->rows);
+
+        if (array->layout == BIT2_ROWS) {
+                memcpy(Bit2_row_unchecked(array, row), span,
+                       array->stride * sizeof(Bit2_word));
+                return;
+        }
+        Bit2_word *blocks = array->words +
+                            (long)(row / BIT2_BLOCK_SIDE) * array->stride;
+        int shift = (row % BIT2_BLOCK_SIDE) * BIT2_BLOCK_SIDE;
+        for (int b = 0; b < array->stride; b++) {
+                Bit2_word byte = (span[b / BIT2_BLOCK_SIDE] >>
+                                  (BIT2_BLOCK_SIDE * (b % BIT2_BLOCK_SIDE))) &
+                                 0xff;
+                blocks[b] = (blocks[b] & ~((Bit2_word)0xff << shift)) |
+                            byte << shift;
+        }
 }
 
 /**********Bit2_map_row_major********
@@ -157,7 +481,9 @@ void Bit2_map_row_major(T2 array, void apply(int col, int row, T2 array,
         /* creating a nested loop such that column indices vary more rapidly */
         for (int i = 0; i < array->rows; i++) {
                 for (int j = 0; j < array->cols; j++) {
-                        apply(j, i, array, Bit2_get(array, j, i), cl);
+                        int shift;
+                        Bit2_word word = *Bit2_word_at(array, j, i, &shift);
+                        apply(j, i, array, (word >> shift) & 1, cl);
                 }
         }                
 }
@@ -176,17 +502,58 @@ void Bit2_map_row_major(T2 array, void apply(int col, int row, T2 array,
 ************************/
 void Bit2_map_col_major(T2 array, void apply(int col, int row, T2 array,
                                int bit, void *p1), void *cl) {
-        /* creating a nested loop such that row indices vary more rapidly */
+        /* creating a nested loop such that row indices vary more rapidly;
+         * with BIT2_BLOCKED eight rows in a row come from the same word */
         for (int j = 0; j < array->cols; j++) {
                 for (int i = 0; i < array->rows; i++) {
-                        apply(j, i, array, Bit2_get(array, j, i), cl);
+                        int shift;
+                        Bit2_word word = *Bit2_word_at(array, j, i, &shift);
+                        apply(j, i, array, (word >> shift) & 1, cl);
                 }
         }                        
 }
 
+/**********Bit2_map_rows********
+ * About: This function traverses the 2D vector a row at a time, from the
+ * first row to the last, giving apply the whole span of each row instead of
+ * one bit per call. A vector stored in blocks has each row gathered into a
+ * span before apply and stored back after it.
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D vector
+ * apply function: the function to be applied on every row; it gets the row
+ *                 index, the span of the row and the number of words in it
+ * cl pointer: client specific pointer input
+ * Return: none
+ * Expects
+ * - non-null T2 array
+ * - that apply keeps the padding bits of the span set to 0
+************************/
+void Bit2_map_rows(T2 array, void apply(int row, Bit2_word *span, int words,
+                   T2 array, void *p1), void *cl) {
+        assert(array != NULL);
+
+        if (array->layout == BIT2_ROWS) {
+                for (int i = 0; i < array->rows; i++) {
+                        apply(i, Bit2_row_unchecked(array, i), array->stride,
+                              array, cl);
+                }
+                return;
+        }
+
+        int words = (array->cols + BIT2_WORD_BITS - 1) / BIT2_WORD_BITS;
+        Bit2_word *span = CALLOC(words, sizeof(Bit2_word));
+        for (int i = 0; i < array->rows; i++) {
+                Bit2_get_row(array, i, span);
+                apply(i, span, words, array, cl);
+                Bit2_put_row(array, i, span);
+        }
+        FREE(span);
+}
+
 /**********Bit2_free********
  * About: This function frees the memory allocated to the 2D vector and the T2
- *        struct
+ *        struct. The memory of a vector made by Bit2_new_pool stays in its
+ *        pool until the pool is reset.
  * Inputs: 
  * T2 *array: address of the 2D vector to store the content of the given data
  * Return: none
@@ -195,10 +562,13 @@ void Bit2_map_col_major(T2 array, void apply(int col, int row, T2 array,
  * Bit2_new function
 ************************/
 void Bit2_free(T2 *array) {
+        if ((*array)->pool != NULL) {
+                *array = NULL;
+                return;
+        }
         
-        /* freeing the bit vector held by the struct */
-        Bit_T vectorToFree = (*array)->data;
-        Bit_free(&vectorToFree);
+        /* freeing the words held by the struct, which came from calloc */
+        free((*array)->words);
 
         /* freeing the struct */
         FREE(*array);
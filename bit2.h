@@ -7,28 +7,131 @@
  *     store the bit data in. It also has functions that helps theclient to 
  *     get the width, height, and element size information about the vector,
  *     traverse the vector in row major and column major order, and access
- *     to an element at a certain location.
+ *     to an element at a certain location. Rows can also be accessed as spans
+ *     of words so that a client can process 64 bits with one operation.
+ *     A vector can instead be stored in 8x8 blocks of bits, so that walking
+ *     down a column or visiting the 4 neighbours of a bit stays in the same
+ *     word or cache line. A vector can also take its memory from a Pool_T, in
+ *     which case resetting the pool frees it, and running out of memory is
+ *     reported by a NULL vector instead of Mem_Failed. Unchecked accessors are
+ *     defined inline below for inner loops that have already checked their
+ *     indices; compiling with -DBIT2_CHECKED makes them assert their indices
+ *     like Bit2_get does.
  *     
  */
 
 #ifndef BIT2_INCLUDED
 #define BIT2_INCLUDED
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <pool.h>
+#ifdef BIT2_CHECKED
+#include <assert.h>
+#endif
+
 #define T2 Bit2_T
 typedef struct T2 *T2;
 
-#include <bit.h>
+/* Each row is stored as a span of machine words.  Column col of a row lives
+ * in bit (col % BIT2_WORD_BITS) of word (col / BIT2_WORD_BITS), and the
+ * unused bits after the last column of every row are always 0. */
+typedef uint64_t Bit2_word;
+#define BIT2_WORD_BITS 64
+
+/* How the bits of a vector are stored, chosen when the vector is created.
+ * BIT2_ROWS stores each row as a span of words as described above, and is
+ * the only layout with row spans.  BIT2_BLOCKED stores every 8x8 block of
+ * bits in one word, bit (row % 8) * 8 + (col % 8), with the blocks in row
+ * major order. A row of either layout can be copied out to or in from a
+ * span with Bit2_get_row and Bit2_put_row. */
+typedef enum { BIT2_ROWS, BIT2_BLOCKED } Bit2_Layout;
+#define BIT2_BLOCK_SIDE 8
 
 extern T2 Bit2_new(int col, int row);
+extern T2 Bit2_new_layout(int col, int row, Bit2_Layout layout);
+extern T2 Bit2_new_pool(int col, int row, Bit2_Layout layout, Pool_T pool);
+extern T2 Bit2_copy_layout(T2 array, Bit2_Layout layout);
+extern bool Bit2_reshape(T2 array, int col, int row);
 extern int Bit2_width(T2 array);
 extern int Bit2_height(T2 array);
+extern Bit2_Layout Bit2_layout(T2 array);
+extern int Bit2_row_words(T2 array);
+extern Bit2_word Bit2_last_word_mask(T2 array);
+extern const Bit2_word *Bit2_row(T2 array, int row);
+extern Bit2_word *Bit2_row_mut(T2 array, int row);
+extern void Bit2_get_row(T2 array, int row, Bit2_word *span);
+extern void Bit2_put_row(T2 array, int row, const Bit2_word *span);
 extern int Bit2_put(T2 array, int col, int row, int bit);
 extern int Bit2_get(T2 array, int col, int row);
 extern void Bit2_map_row_major(T2 array, void apply(int col, int row, T2 array,
                                int bit, void *p1), void *cl);
 extern void Bit2_map_col_major(T2 array, void apply(int col, int row, T2 array,
                                int bit, void *p1), void *cl);
+extern void Bit2_map_rows(T2 array, void apply(int row, Bit2_word *span,
+                          int words, T2 array, void *p1), void *cl);
 extern void Bit2_free(T2 *array);
 
-#undef T
+/* The representation is only visible so that the unchecked accessors can be
+ * inlined; clients should not touch its fields. */
+struct T2 {
+        int rows; /* number of rows in in the 2D vector, at least 1 */
+        int cols; /* number of cols in in the 2D vector, at least 1 */
+        Bit2_Layout layout; /* how the bits are stored in words */
+        int stride; /* number of words holding one row (of blocks for
+                     * BIT2_BLOCKED), padding included */
+        Bit2_word *words; /* the words representing the 2D vector */
+        long capacity; /* number of words allocated in words */
+        Pool_T pool; /* the pool the vector lives in, or NULL for Mem */
+};
+
+#ifdef BIT2_CHECKED
+#define BIT2_CHECK(e) assert(e)
+#else
+#define BIT2_CHECK(e) ((void)0)
+#endif
+
+/* the word holding bit [col, row] of either layout, and its bit index */
+static inline Bit2_word *Bit2_word_at(T2 array, int col, int row, int *shift)
+{
+        BIT2_CHECK(col >= 0 && col < array->cols);
+        BIT2_CHECK(row >= 0 && row < array->rows);
+        if (array->layout == BIT2_BLOCKED) {
+                *shift = (row % BIT2_BLOCK_SIDE) * BIT2_BLOCK_SIDE +
+                         col % BIT2_BLOCK_SIDE;
+                return array->words + (long)(row / BIT2_BLOCK_SIDE) *
+                       array->stride + col / BIT2_BLOCK_SIDE;
+        }
+        *shift = col % BIT2_WORD_BITS;
+        return array->words + (long)row * array->stride +
+               col / BIT2_WORD_BITS;
+}
+
+/* Bit2_get without the checks */
+static inline int Bit2_get_unchecked(T2 array, int col, int row)
+{
+        int shift;
+        Bit2_word word = *Bit2_word_at(array, col, row, &shift);
+        return (word >> shift) & 1;
+}
+
+/* Bit2_put without the checks, and without returning the old bit */
+static inline void Bit2_put_unchecked(T2 array, int col, int row, int bit)
+{
+        BIT2_CHECK(bit == 0 || bit == 1);
+        int shift;
+        Bit2_word *word = Bit2_word_at(array, col, row, &shift);
+        *word = (*word & ~((Bit2_word)1 << shift)) | ((Bit2_word)bit << shift);
+}
+
+/* Bit2_row_mut without the checks; BIT2_ROWS only */
+static inline Bit2_word *Bit2_row_unchecked(T2 array, int row)
+{
+        BIT2_CHECK(array->layout == BIT2_ROWS);
+        BIT2_CHECK(row >= 0 && row < array->rows);
+        return array->words + (long)row * array->stride;
+}
+
+#undef BIT2_CHECK
+#undef T2
 #endif
\ No newline at end of file
@@ -0,0 +1,467 @@
+/*
+ *     cleanBatch.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file cleans the black edges of many pbm files in one run.
+ *     The paths are collected first, from the command line and from a manifest
+ *     holding one path per line. A fixed number of worker threads then take
+ *     the next path from a shared index, so a large image does not hold up the
+ *     files behind it. A worker reads its file into a buffer with a single
+ *     read, cleans it with the chosen engine and writes it into the output
+ *     directory under the last component of its path. The bitmap, the stack
+ *     and the arrays of the engine for a file are taken from a pool owned by
+ *     the worker, which is reset before the next file, and the read buffer is
+ *     kept, so after the largest file nothing is allocated and the threads
+ *     never contend in the allocator. A file that is not a valid pbm is
+ *     reported and skipped. Since the results are named after the last
+ *     component of their paths alone, two inputs sharing it would overwrite
+ *     each other, so the names are sorted and checked for clashes before any
+ *     worker starts, and a batch with a clash is refused as a whole.
+ *     When instrumented, every file gets its own line of statistics, with
+ *     the CPU time of the worker thread that cleaned it.
+ */
+
+/* getline and sysconf are POSIX, not part of c99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <mem.h>
+#include <pool.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <pbmReadWrite.h>
+#include <clearEngine.h>
+#include <cleanBatch.h>
+#include <cleanStats.h>
+
+/**********struct Batch********
+ * About: This struct holds the files of a run and what the workers share
+************************/
+typedef struct Batch {
+        char **paths; /* the input files, owned by the batch */
+        int length; /* the number of paths */
+        int capacity; /* the number of paths that fit in paths */
+        int next; /* index of the next path to clean, guarded by lock */
+        int failed; /* the number of files that failed, guarded by lock */
+        pthread_mutex_t lock; /* guards next and failed */
+        const char *outDir; /* the directory the results are written to */
+        Engine engine; /* the engine clearing the edges */
+        int format; /* PBM_PLAIN or PBM_RAW for the results */
+        bool instrument; /* true to print statistics for every file */
+} Batch;
+
+/* the size of the chunks of the pool of a worker */
+#define WORKER_POOL_CHUNK (1 << 20)
+
+/**********struct Worker********
+ * About: This struct holds what one thread reuses between its files
+************************/
+typedef struct Worker {
+        Batch *batch; /* the batch the files are taken from */
+        Pool_T pool; /* holds the bitmap, stack and engine arrays of the
+                        current file */
+        unsigned char *buffer; /* the bytes of the file being read */
+        size_t capacity; /* the number of bytes that fit in buffer */
+} Worker;
+
+/* function declarations */
+void batchAddPath(Batch *batch, const char *path);
+bool batchReadManifest(Batch *batch, const char *manifest);
+bool batchCheckNames(Batch *batch);
+int batchCompareNames(const void *path1, const void *path2);
+const char *batchBaseName(const char *path);
+void *batchWorker(void *cl);
+bool batchCleanFile(Worker *worker, const char *path);
+bool batchReadFile(Worker *worker, const char *path, size_t *length);
+double batchNow(void);
+
+/**********cleanBatch********
+ * About: This function cleans every given file with a pool of threads and
+ *        writes the results into outDir, printing a line to stderr for
+ *        every file that fails and a summary with the number of files
+ *        cleaned per second at the end
+ * Inputs:
+ * int count: the number of names
+ * char *names[]: the pbm files to clean
+ * const char *manifest: a file listing more pbm files, one per line ("-"
+ *                       for stdin), or NULL
+ * const char *outDir: the existing directory the results are written to
+ * Engine engine: the engine clearing the black edges
+ * int format: PBM_PLAIN or PBM_RAW for the results
+ * int threads: the number of threads, 0 (or less) for one per online
+ *              processor
+ * bool instrument: true to print a line of statistics for every file to
+ *                  stderr with statsPrint
+ * Return: true if every file was cleaned and written, false otherwise; no
+ *         file is cleaned when two of them share their last component
+ * Expects
+ * - names to be non-null if count is positive, and outDir to be non-null
+************************/
+bool cleanBatch(int count, char *names[], const char *manifest,
+                const char *outDir, Engine engine, int format, int threads,
+                bool instrument) {
+        assert(outDir != NULL && (count == 0 || names != NULL));
+        assert(format == PBM_PLAIN || format == PBM_RAW);
+
+        Batch batch;
+        memset(&batch, 0, sizeof(batch));
+        batch.outDir = outDir;
+        batch.engine = engine;
+        batch.format = format;
+        batch.instrument = instrument;
+        pthread_mutex_init(&batch.lock, NULL);
+
+        for (int i = 0; i < count; i++) {
+                batchAddPath(&batch, names[i]);
+        }
+        bool listed = manifest == NULL || batchReadManifest(&batch, manifest);
+        if (!batchCheckNames(&batch)) {
+                /* refusing the whole batch, so every file counts as failed */
+                batch.next = batch.length;
+                batch.failed = batch.length;
+        }
+
+        /* starting no more workers than there are files */
+        if (threads <= 0) {
+                threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        if (threads > batch.length) {
+                threads = batch.length;
+        }
+        if (threads < 1) {
+                threads = 1;
+        }
+        double start = batchNow();
+        Worker *workers = CALLOC(threads, sizeof(Worker));
+        pthread_t *ids = CALLOC(threads, sizeof(pthread_t));
+        for (int t = 0; t < threads; t++) {
+                workers[t].batch = &batch;
+                int failed = pthread_create(&ids[t], NULL, batchWorker,
+                                            &workers[t]);
+                assert(failed == 0);
+                (void)failed;
+        }
+        for (int t = 0; t < threads; t++) {
+                pthread_join(ids[t], NULL);
+        }
+        double seconds = batchNow() - start;
+
+        fprintf(stderr, "%d files: %d cleaned, %d failed in %.6f s with %d "
+                "threads (%.0f files/s)\n", batch.length,
+                batch.length - batch.failed, batch.failed, seconds, threads,
+                seconds > 0 ? batch.length / seconds : 0.0);
+
+        bool allCleaned = listed && batch.failed == 0;
+        FREE(ids);
+        FREE(workers);
+        for (int i = 0; i < batch.length; i++) {
+                FREE(batch.paths[i]);
+        }
+        FREE(batch.paths);
+        pthread_mutex_destroy(&batch.lock);
+        return allCleaned;
+}
+
+/**********batchAddPath********
+ * About: This function adds a copy of a path to the files of the batch
+ * Inputs:
+ * Batch *batch: the batch
+ * const char *path: the path of the file
+ * Return: none
+************************/
+void batchAddPath(Batch *batch, const char *path) {
+        if (batch->length == batch->capacity) {
+                batch->capacity = batch->capacity == 0 ? 64 :
+                                  2 * batch->capacity;
+                if (batch->paths == NULL) {
+                        batch->paths = ALLOC(batch->capacity *
+                                             sizeof(char *));
+                }
+                else {
+                        RESIZE(batch->paths, batch->capacity *
+                               sizeof(char *));
+                }
+        }
+        char *copy = ALLOC(strlen(path) + 1);
+        strcpy(copy, path);
+        batch->paths[batch->length++] = copy;
+}
+
+/**********batchReadManifest********
+ * About: This function adds every path listed in a manifest to the batch.
+ *        Each line holds one path; empty lines are skipped.
+ * Inputs:
+ * Batch *batch: the batch
+ * const char *manifest: the name of the manifest, "-" for stdin
+ * Return: true if the manifest could be read, false otherwise
+************************/
+bool batchReadManifest(Batch *batch, const char *manifest) {
+        FILE *fp = strcmp(manifest, "-") == 0 ? stdin : fopen(manifest, "r");
+        if (fp == NULL) {
+                fprintf(stderr, "unblackedges: cannot open manifest %s\n",
+                        manifest);
+                return false;
+        }
+
+        char *line = NULL;
+        size_t size = 0;
+        ssize_t length;
+        while ((length = getline(&line, &size, fp)) != -1) {
+                while (length > 0 && (line[length - 1] == '\n' ||
+                                      line[length - 1] == '\r')) {
+                        line[--length] = '\0';
+                }
+                if (length > 0) {
+                        batchAddPath(batch, line);
+                }
+        }
+        /* getline allocates with malloc, not with Mem */
+        free(line);
+        if (fp != stdin) {
+                fclose(fp);
+        }
+        return true;
+}
+
+/**********batchCheckNames********
+ * About: This function checks that no two files of the batch would be
+ *        written to the same result, printing a line to stderr for every
+ *        file whose last component clashes with that of an earlier one
+ * Inputs:
+ * Batch *batch: the batch
+ * Return: true if every file has a last component of its own, false
+ *         otherwise
+************************/
+bool batchCheckNames(Batch *batch) {
+        if (batch->length < 2) {
+                return true;
+        }
+
+        /* sorting by last component puts the clashing paths side by side */
+        char **sorted = ALLOC(batch->length * sizeof(char *));
+        memcpy(sorted, batch->paths, batch->length * sizeof(char *));
+        qsort(sorted, batch->length, sizeof(char *), batchCompareNames);
+
+        bool unique = true;
+        for (int i = 1; i < batch->length; i++) {
+                if (strcmp(batchBaseName(sorted[i - 1]),
+                           batchBaseName(sorted[i])) == 0) {
+                        fprintf(stderr, "unblackedges: %s and %s would both "
+                                "be written to %s/%s\n", sorted[i - 1],
+                                sorted[i], batch->outDir,
+                                batchBaseName(sorted[i]));
+                        unique = false;
+                }
+        }
+        FREE(sorted);
+        return unique;
+}
+
+/**********batchCompareNames********
+ * About: This function is a qsort compare function ordering paths by their
+ *        last component, then by the whole path
+ * Inputs:
+ * const void *path1: pointer to the first path
+ * const void *path2: pointer to the second path
+ * Return: less than, equal to or greater than 0 as the first path sorts
+ *         before, with or after the second
+************************/
+int batchCompareNames(const void *path1, const void *path2) {
+        const char *name1 = *(const char * const *)path1;
+        const char *name2 = *(const char * const *)path2;
+        int order = strcmp(batchBaseName(name1), batchBaseName(name2));
+        return order != 0 ? order : strcmp(name1, name2);
+}
+
+/**********batchBaseName********
+ * About: This function finds the last component of a path, which names its
+ *        result in the output directory
+ * Inputs:
+ * const char *path: the path
+ * Return: the part of path after its last slash, or path if it has none
+************************/
+const char *batchBaseName(const char *path) {
+        const char *slash = strrchr(path, '/');
+        return slash == NULL ? path : slash + 1;
+}
+
+/**********batchWorker********
+ * About: This function is the body of a thread. It cleans the next file of
+ *        the batch until none are left, then frees what it reused.
+ * Inputs:
+ * void *cl: the Worker of the thread
+ * Return: NULL
+************************/
+void *batchWorker(void *cl) {
+        Worker *worker = cl;
+        Batch *batch = worker->batch;
+        worker->pool = Pool_new(WORKER_POOL_CHUNK);
+
+        for (;;) {
+                pthread_mutex_lock(&batch->lock);
+                int index = batch->next++;
+                pthread_mutex_unlock(&batch->lock);
+                if (index >= batch->length) {
+                        break;
+                }
+                if (!batchCleanFile(worker, batch->paths[index])) {
+                        pthread_mutex_lock(&batch->lock);
+                        batch->failed++;
+                        pthread_mutex_unlock(&batch->lock);
+                }
+        }
+
+        if (worker->pool != NULL) {
+                Pool_free(&worker->pool);
+        }
+        if (worker->buffer != NULL) {
+                FREE(worker->buffer);
+        }
+        return NULL;
+}
+
+/**********batchCleanFile********
+ * About: This function reads, cleans and writes one file, after releasing
+ *        the memory of the previous file of the worker
+ * Inputs:
+ * Worker *worker: the worker, whose pool and buffer are used
+ * const char *path: the path of the file
+ * Return: true if the file was cleaned and written, false otherwise
+************************/
+bool batchCleanFile(Worker *worker, const char *path) {
+        Batch *batch = worker->batch;
+        CleanStats stats;
+        statsInit(&stats, path, true);
+
+        Bit2_T bitmap = NULL;
+        Frontier_T stack = NULL;
+        if (worker->pool != NULL) {
+                Pool_reset(worker->pool);
+                bitmap = Bit2_new_pool(1, 1, BIT2_ROWS, worker->pool);
+                stack = Frontier_new_pool(100, worker->pool);
+        }
+        if (bitmap == NULL || stack == NULL) {
+                fprintf(stderr, "unblackedges: out of memory for %s\n", path);
+                return false;
+        }
+
+        statsStart(&stats);
+        size_t length;
+        if (!batchReadFile(worker, path, &length)) {
+                fprintf(stderr, "unblackedges: cannot read %s\n", path);
+                return false;
+        }
+        PbmReadStatus status = pbmReadBuffer(worker->buffer, length, bitmap);
+        if (status != PBM_READ_OK) {
+                fprintf(stderr, status == PBM_READ_BAD ?
+                        "unblackedges: %s is not a pbm file\n" :
+                        "unblackedges: out of memory for %s\n", path);
+                return false;
+        }
+        statsStop(&stats, STATS_READ);
+
+        /* the pool already uses the processors, so one thread per image */
+        if (batch->instrument) {
+                statsBeforeClear(&stats, bitmap, stack);
+        }
+        statsStart(&stats);
+        bool cleared = engineClearEdges(batch->engine, bitmap, stack,
+                                        worker->pool, 1);
+        statsStop(&stats, STATS_CLEAR);
+        if (!cleared) {
+                if (batch->instrument) {
+                        Bit2_free(&stats.before);
+                }
+                fprintf(stderr, "unblackedges: out of memory for %s\n", path);
+                return false;
+        }
+        if (batch->instrument) {
+                stats.poolBytes = Pool_used(worker->pool);
+                statsAfterClear(&stats, bitmap, stack, worker->pool);
+        }
+
+        /* writing under the last component of the input path */
+        const char *name = batchBaseName(path);
+        size_t size = strlen(batch->outDir) + strlen(name) + 2;
+        char *outPath = ALLOC(size);
+        snprintf(outPath, size, "%s/%s", batch->outDir, name);
+        statsStart(&stats);
+        FILE *out = fopen(outPath, "wb");
+        bool written = out != NULL;
+        if (written) {
+                pbmWrite(out, bitmap, batch->format);
+                written = !ferror(out);
+                written = fclose(out) == 0 && written;
+        }
+        statsStop(&stats, STATS_WRITE);
+        if (!written) {
+                fprintf(stderr, "unblackedges: cannot write %s\n", outPath);
+        }
+        else if (batch->instrument) {
+                statsPrint(&stats, stderr);
+        }
+        FREE(outPath);
+        return written;
+}
+
+/**********batchReadFile********
+ * About: This function reads a whole file into the buffer of a worker,
+ *        growing the buffer when the file does not fit
+ * Inputs:
+ * Worker *worker: the worker
+ * const char *path: the path of the file
+ * size_t *length: where the number of bytes read is stored
+ * Return: true if the file was read, false otherwise
+************************/
+bool batchReadFile(Worker *worker, const char *path, size_t *length) {
+        FILE *fp = fopen(path, "rb");
+        if (fp == NULL) {
+                return false;
+        }
+        if (worker->buffer == NULL) {
+                worker->capacity = 1 << 16;
+                worker->buffer = ALLOC(worker->capacity);
+        }
+
+        /* starting with the size of the file, so one read is usually enough */
+        if (fseek(fp, 0, SEEK_END) == 0) {
+                long size = ftell(fp);
+                if (size >= 0 && (size_t)size >= worker->capacity) {
+                        worker->capacity = (size_t)size + 1;
+                        RESIZE(worker->buffer, worker->capacity);
+                }
+                rewind(fp);
+        }
+        size_t got = 0;
+        for (;;) {
+                got += fread(worker->buffer + got, 1, worker->capacity - got,
+                             fp);
+                if (got < worker->capacity) {
+                        break;
+                }
+                worker->capacity *= 2;
+                RESIZE(worker->buffer, worker->capacity);
+        }
+        bool read = !ferror(fp);
+        fclose(fp);
+        *length = got;
+        return read;
+}
+
+/**********batchNow********
+ * About: This function reads a monotonic clock
+ * Return: the time in seconds from an arbitrary start
+************************/
+double batchNow(void) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+}
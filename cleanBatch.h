@@ -0,0 +1,25 @@
+/*
+ *     cleanBatch.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to clean the black edges of many pbm
+ *     files in one run. The files are given by name or listed in a manifest,
+ *     cleaned by a fixed pool of threads that each reuse one bitmap, one
+ *     stack and one read buffer for all their files, and written under the
+ *     same names into an output directory. A batch in which two files share
+ *     a name is refused before any file is cleaned.
+ *
+ */
+
+#ifndef CLEANBATCH_INCLUDED
+#define CLEANBATCH_INCLUDED
+
+#include <stdbool.h>
+#include <clearEngine.h>
+
+extern bool cleanBatch(int count, char *names[], const char *manifest,
+                       const char *outDir, Engine engine, int format,
+                       int threads, bool instrument);
+
+#endif
@@ -0,0 +1,242 @@
+/*
+ *     cleanStats.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file measures the phases of cleaning an image. Wall time is
+ *     read from the monotonic clock and CPU time from the process clock, or
+ *     the thread clock when many images are cleaned at once by a pool of
+ *     threads. The counters are found by comparing the image before and
+ *     after clearing: the bits that were cleared are labelled with
+ *     runLabel, and every root of the union-find forest is one black edge
+ *     component. The copy and the labelling happen outside of the timed
+ *     phases, so only the counters cost extra.
+ */
+
+/* clock_gettime and its CPU clocks are POSIX, not part of c99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <time.h>
+#include <mem.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <pool.h>
+#include <runLabel.h>
+#include <cleanStats.h>
+
+/* function declarations */
+double statsClock(clockid_t clock);
+void statsPrintName(const char *name, FILE *out);
+
+/**********statsEnabled********
+ * About: This function decides if statistics are collected: they are when
+ *        the flag is set, or when STATS_ENV is set to anything but "" or "0"
+ * Inputs:
+ * bool flag: true if the -i option was given
+ * Return: true if statistics should be collected
+************************/
+bool statsEnabled(bool flag) {
+        const char *env = getenv(STATS_ENV);
+        return flag || (env != NULL && env[0] != '\0' &&
+                        strcmp(env, "0") != 0);
+}
+
+/**********statsInit********
+ * About: This function starts the measurements of an image at zero
+ * Inputs:
+ * CleanStats *stats: the measurements
+ * const char *image: the name of the image, which must outlive stats
+ * bool threadClock: true to measure the CPU time of the calling thread
+ * Return: none
+ * Expects
+ * - stats and image to be non-null
+************************/
+void statsInit(CleanStats *stats, const char *image, bool threadClock) {
+        assert(stats != NULL && image != NULL);
+        memset(stats, 0, sizeof(*stats));
+        stats->image = image;
+        stats->threadClock = threadClock;
+}
+
+/**********statsStart********
+ * About: This function reads the clocks at the start of a phase
+ * Inputs:
+ * CleanStats *stats: the measurements
+ * Return: none
+************************/
+void statsStart(CleanStats *stats) {
+        stats->wallStart = statsClock(CLOCK_MONOTONIC);
+        stats->cpuStart = statsClock(stats->threadClock ?
+                                     CLOCK_THREAD_CPUTIME_ID :
+                                     CLOCK_PROCESS_CPUTIME_ID);
+}
+
+/**********statsStop********
+ * About: This function adds the time since statsStart to a phase
+ * Inputs:
+ * CleanStats *stats: the measurements
+ * StatsPhase phase: the phase that ended
+ * Return: none
+************************/
+void statsStop(CleanStats *stats, StatsPhase phase) {
+        assert(phase >= STATS_READ && phase < STATS_PHASES);
+        stats->wall[phase] += statsClock(CLOCK_MONOTONIC) - stats->wallStart;
+        stats->cpu[phase] += statsClock(stats->threadClock ?
+                                        CLOCK_THREAD_CPUTIME_ID :
+                                        CLOCK_PROCESS_CPUTIME_ID) -
+                             stats->cpuStart;
+}
+
+/**********statsBeforeClear********
+ * About: This function keeps a copy of the image and starts the statistics
+ *        of the stack over, just before the black edges are cleared
+ * Inputs:
+ * CleanStats *stats: the measurements
+ * Bit2_T bitmap: the image about to be cleared, in either layout
+ * Frontier_T stack: the stack the engine will use
+ * Return: none
+ * Expects
+ * - bitmap and stack to be non-null
+************************/
+void statsBeforeClear(CleanStats *stats, Bit2_T bitmap, Frontier_T stack) {
+        assert(bitmap != NULL && stack != NULL);
+        stats->width = Bit2_width(bitmap);
+        stats->height = Bit2_height(bitmap);
+        stats->before = Bit2_copy_layout(bitmap, BIT2_ROWS);
+        Frontier_reset_stats(stack);
+}
+
+/**********statsAfterClear********
+ * About: This function counts the bits and components that were cleared
+ *        and reads the statistics of the stack, then frees the copy made
+ *        by statsBeforeClear
+ * Inputs:
+ * CleanStats *stats: the measurements
+ * Bit2_T bitmap: the image that was cleared, in either layout
+ * Frontier_T stack: the stack the engine used
+ * Pool_T pool: the pool the labels of the cleared bits are taken from;
+ *              if it runs out of memory the components are not counted and
+ *              are reported as -1
+ * Return: none
+ * Expects
+ * - statsBeforeClear to have been called with the same bitmap
+ * - pool to be non-null
+************************/
+void statsAfterClear(CleanStats *stats, Bit2_T bitmap, Frontier_T stack,
+                     Pool_T pool) {
+        assert(stats->before != NULL && bitmap != NULL && stack != NULL);
+        assert(pool != NULL);
+        int words = Bit2_row_words(stats->before);
+        bool blocked = Bit2_layout(bitmap) == BIT2_BLOCKED;
+        Bit2_word *scratch = blocked ? CALLOC(words, sizeof(Bit2_word)) :
+                             NULL;
+
+        /* keeping only the bits that were cleared in the copy */
+        for (int row = 0; row < stats->height; row++) {
+                Bit2_word *cleared = Bit2_row_mut(stats->before, row);
+                const Bit2_word *span = scratch;
+                if (blocked) {
+                        Bit2_get_row(bitmap, row, scratch);
+                }
+                else {
+                        span = Bit2_row(bitmap, row);
+                }
+                for (int w = 0; w < words; w++) {
+                        cleared[w] &= ~span[w];
+                        stats->cleared += __builtin_popcountll(cleared[w]);
+                }
+        }
+        if (blocked) {
+                FREE(scratch);
+        }
+
+        RunLabels labels;
+        if (!RunLabels_init(&labels, stats->before, 0, stats->height,
+                            pool)) {
+                stats->components = -1;
+                labels.length = 0;
+        }
+        for (long label = 0; label < labels.length; label++) {
+                if (RunLabels_find(labels.parent, label) == label) {
+                        stats->components++;
+                }
+        }
+        Bit2_free(&stats->before);
+
+        stats->peakFrontier = Frontier_peak(stack);
+        stats->frontierBytes = Frontier_peak_bytes(stack);
+        stats->frontierAllocations = Frontier_allocations(stack);
+}
+
+/**********statsPrint********
+ * About: This function prints the measurements of an image as one line of
+ *        JSON, holding the lock of out so that lines printed by several
+ *        threads do not mix
+ * Inputs:
+ * const CleanStats *stats: the measurements
+ * FILE *out: where the line is printed
+ * Return: none
+************************/
+void statsPrint(const CleanStats *stats, FILE *out) {
+        assert(stats != NULL && out != NULL);
+        flockfile(out);
+        fputs("{\"image\": ", out);
+        statsPrintName(stats->image, out);
+        fprintf(out, ", \"width\": %d, \"height\": %d, "
+                "\"read_wall_s\": %.6f, \"read_cpu_s\": %.6f, "
+                "\"clear_wall_s\": %.6f, \"clear_cpu_s\": %.6f, "
+                "\"write_wall_s\": %.6f, \"write_cpu_s\": %.6f, "
+                "\"pixels_cleared\": %ld, \"components_removed\": %ld, "
+                "\"peak_frontier\": %ld, \"frontier_bytes\": %ld, "
+                "\"frontier_allocations\": %d, \"pool_bytes\": %ld}\n",
+                stats->width,
+                stats->height, stats->wall[STATS_READ],
+                stats->cpu[STATS_READ], stats->wall[STATS_CLEAR],
+                stats->cpu[STATS_CLEAR], stats->wall[STATS_WRITE],
+                stats->cpu[STATS_WRITE], stats->cleared, stats->components,
+                stats->peakFrontier, stats->frontierBytes,
+                stats->frontierAllocations, stats->poolBytes);
+        funlockfile(out);
+}
+
+/**********statsPrintName********
+ * About: This function prints a name as a JSON string, escaping quotes,
+ *        backslashes and control characters
+ * Inputs:
+ * const char *name: the name
+ * FILE *out: where the string is printed
+ * Return: none
+************************/
+void statsPrintName(const char *name, FILE *out) {
+        putc('"', out);
+        for (const unsigned char *c = (const unsigned char *)name; *c != '\0';
+             c++) {
+                if (*c == '"' || *c == '\\') {
+                        fprintf(out, "\\%c", *c);
+                }
+                else if (*c < 0x20) {
+                        fprintf(out, "\\u%04x", *c);
+                }
+                else {
+                        putc(*c, out);
+                }
+        }
+        putc('"', out);
+}
+
+/**********statsClock********
+ * About: This function reads a clock
+ * Inputs:
+ * clockid_t clock: the clock to read
+ * Return: the time in seconds from an arbitrary start
+************************/
+double statsClock(clockid_t clock) {
+        struct timespec now;
+        clock_gettime(clock, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+}
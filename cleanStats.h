@@ -0,0 +1,60 @@
+/*
+ *     cleanStats.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to measure where the time of cleaning an
+ *     image goes. The wall and CPU time of the read, clear and write phases
+ *     are recorded along with counters about the clearing, and printed as
+ *     one line of JSON per image.
+ *
+ */
+
+#ifndef CLEANSTATS_INCLUDED
+#define CLEANSTATS_INCLUDED
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <pool.h>
+
+/* the environment variable that turns the statistics on without -i */
+#define STATS_ENV "UNBLACKEDGES_STATS"
+
+/* the phases that are timed */
+typedef enum { STATS_READ, STATS_CLEAR, STATS_WRITE } StatsPhase;
+#define STATS_PHASES 3
+
+/**********struct CleanStats********
+ * About: This struct holds the measurements of one image
+************************/
+typedef struct CleanStats {
+        const char *image; /* the name of the image */
+        bool threadClock; /* true to measure the CPU time of this thread
+                             only, false for the whole process */
+        double wall[STATS_PHASES]; /* wall time of each phase in seconds */
+        double cpu[STATS_PHASES]; /* CPU time of each phase in seconds */
+        double wallStart, cpuStart; /* clocks at the start of the phase */
+        int width, height; /* the size of the image */
+        long cleared; /* number of black bits made white */
+        long components; /* number of black edge components removed, or -1
+                            if there was no memory to count them */
+        long peakFrontier; /* peak length of the stack of the engine */
+        long frontierBytes; /* bytes held by the stack at its peak */
+        int frontierAllocations; /* allocations made by the stack */
+        long poolBytes; /* bytes taken from the pool of the image, if any */
+        Bit2_T before; /* copy of the image before clearing, or NULL */
+} CleanStats;
+
+extern bool statsEnabled(bool flag);
+extern void statsInit(CleanStats *stats, const char *image, bool threadClock);
+extern void statsStart(CleanStats *stats);
+extern void statsStop(CleanStats *stats, StatsPhase phase);
+extern void statsBeforeClear(CleanStats *stats, Bit2_T bitmap,
+                             Frontier_T stack);
+extern void statsAfterClear(CleanStats *stats, Bit2_T bitmap,
+                            Frontier_T stack, Pool_T pool);
+extern void statsPrint(const CleanStats *stats, FILE *out);
+
+#endif
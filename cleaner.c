@@ -0,0 +1,242 @@
+/*
+ *     cleaner.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file is used to create cleaners, which read a pbm file
+ *     from memory with pbmReadBuffer, clear its black edges with the engine
+ *     they were made with, and hand back the cleaned bits in a Bit2_T or as
+ *     a pbm file written by pbmWriteBuffer. Every argument is checked before
+ *     it reaches the asserts of the modules below, so a bad call comes back
+ *     as a Cleaner_Status. Everything a cleaner needs for an image is taken
+ *     from its own pool, which reports running out of memory by returning
+ *     NULL rather than raising Mem_Failed, so every allocation is checked
+ *     where it is made and comes back as CLEANER_NO_MEMORY. Resetting the
+ *     pool at the start of each image gives back what the previous image
+ *     took, including after a failure.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <pool.h>
+#include <clearEngine.h>
+#include <pbmReadWrite.h>
+#include <cleaner.h>
+
+#define T Cleaner_T
+
+/* the starting number of entries of the stack of a cleaner */
+#define CLEANER_STACK_HINT 100
+
+/* the size of the chunks of the pool of a cleaner */
+#define CLEANER_POOL_CHUNK (1 << 20)
+
+/**********struct T********
+ * About: This struct holds what a cleaner reuses from one image to the next
+************************/
+struct T {
+        Engine engine; /* the engine clearing the black edges */
+        int threads; /* the threads of the tiled engine, 0 for one per
+                        online processor */
+        Pool_T pool; /* the bitmap, stack and arrays of the engines, reset
+                        for each image */
+};
+
+/* function declarations */
+Cleaner_Status cleanerRead(const unsigned char *data, size_t length,
+                           Bit2_T bitmap);
+Cleaner_Status cleanerClear(T cleaner, Bit2_T bitmap);
+
+/**********Cleaner_new********
+ * About: This function makes a cleaner that clears the black edges with the
+ *        given engine
+ * Inputs:
+ * Engine engine: the engine clearing the black edges
+ * int threads: the number of threads of the tiled engine, 0 (or less) for
+ *              one per online processor
+ * Return: the cleaner, which the client frees with Cleaner_free, or NULL if
+ *         engine is not one of the engines or there is not enough memory
+************************/
+T Cleaner_new(Engine engine, int threads) {
+        if ((int)engine < 0 || (int)engine >= ENGINE_COUNT) {
+                return NULL;
+        }
+
+        T cleaner = malloc(sizeof(*cleaner));
+        if (cleaner == NULL) {
+                return NULL;
+        }
+        cleaner->engine = engine;
+        cleaner->threads = threads;
+        cleaner->pool = Pool_new(CLEANER_POOL_CHUNK);
+        if (cleaner->pool == NULL) {
+                free(cleaner);
+                return NULL;
+        }
+        return cleaner;
+}
+
+/**********Cleaner_clean********
+ * About: This function reads the pbm file held in a buffer into the given
+ *        bitmap, which is reshaped to the size of the image, and clears its
+ *        black edges
+ * Inputs:
+ * T cleaner: the cleaner
+ * const unsigned char *data: the bytes of a plain or raw pbm file
+ * size_t length: the number of bytes in data
+ * Bit2_T bitmap: a bitmap stored in BIT2_ROWS that receives the result
+ * Return: CLEANER_OK, CLEANER_BAD_ARGUMENT if a pointer is null or bitmap
+ *         is stored in blocks, CLEANER_BAD_INPUT if data is not a pbm file,
+ *         or CLEANER_NO_MEMORY if an allocation failed, in which case the
+ *         contents of bitmap are unspecified
+************************/
+Cleaner_Status Cleaner_clean(T cleaner, const unsigned char *data,
+                             size_t length, Bit2_T bitmap) {
+        if (cleaner == NULL || data == NULL || bitmap == NULL ||
+            Bit2_layout(bitmap) != BIT2_ROWS) {
+                return CLEANER_BAD_ARGUMENT;
+        }
+
+        Pool_reset(cleaner->pool);
+        Cleaner_Status status = cleanerRead(data, length, bitmap);
+        if (status != CLEANER_OK) {
+                return status;
+        }
+        return cleanerClear(cleaner, bitmap);
+}
+
+/**********Cleaner_clean_buffer********
+ * About: This function cleans the pbm file held in a buffer and stores the
+ *        cleaned file in another buffer, exactly as unblackedges would print
+ *        it. The size of the cleaned file only depends on the header, so a
+ *        buffer that is too small is found before any clearing is done.
+ * Inputs:
+ * T cleaner: the cleaner
+ * const unsigned char *data: the bytes of a plain or raw pbm file
+ * size_t length: the number of bytes in data
+ * int format: PBM_PLAIN or PBM_RAW for the cleaned file
+ * unsigned char *out: where the cleaned file is stored, not overlapping data
+ * size_t capacity: the number of bytes that fit in out
+ * size_t *written: where the size of the cleaned file is stored, also when
+ *                  it does not fit
+ * Return: CLEANER_OK, CLEANER_BAD_ARGUMENT if a pointer is null or format
+ *         is not a pbm format, CLEANER_BAD_INPUT if data is not a pbm file,
+ *         CLEANER_SHORT_BUFFER if the cleaned file is more than capacity
+ *         bytes, in which case out is left alone, or CLEANER_NO_MEMORY if
+ *         an allocation failed, in which case out is left alone too
+************************/
+Cleaner_Status Cleaner_clean_buffer(T cleaner, const unsigned char *data,
+                                    size_t length, int format,
+                                    unsigned char *out, size_t capacity,
+                                    size_t *written) {
+        if (cleaner == NULL || data == NULL || out == NULL ||
+            written == NULL || (format != PBM_PLAIN && format != PBM_RAW)) {
+                return CLEANER_BAD_ARGUMENT;
+        }
+
+        /* the image is read into the pool, next to the arrays it needs */
+        Pool_reset(cleaner->pool);
+        Bit2_T bitmap = Bit2_new_pool(1, 1, BIT2_ROWS, cleaner->pool);
+        if (bitmap == NULL) {
+                return CLEANER_NO_MEMORY;
+        }
+        Cleaner_Status status = cleanerRead(data, length, bitmap);
+        if (status != CLEANER_OK) {
+                return status;
+        }
+
+        *written = pbmEncodedSize(format, Bit2_width(bitmap),
+                                  Bit2_height(bitmap));
+        if (*written > capacity) {
+                return CLEANER_SHORT_BUFFER;
+        }
+        status = cleanerClear(cleaner, bitmap);
+        if (status == CLEANER_OK) {
+                pbmWriteBuffer(out, bitmap, format);
+        }
+        return status;
+}
+
+/**********Cleaner_message********
+ * About: This function describes a status in words
+ * Inputs:
+ * Cleaner_Status status: the status
+ * Return: a string the client does not free
+************************/
+const char *Cleaner_message(Cleaner_Status status) {
+        switch (status) {
+        case CLEANER_OK:
+                return "cleaned";
+        case CLEANER_BAD_ARGUMENT:
+                return "bad argument";
+        case CLEANER_BAD_INPUT:
+                return "not a pbm file";
+        case CLEANER_SHORT_BUFFER:
+                return "output buffer too small";
+        case CLEANER_NO_MEMORY:
+                return "out of memory";
+        }
+        return "unknown status";
+}
+
+/**********Cleaner_free********
+ * About: This function frees a cleaner and everything it holds
+ * Inputs:
+ * T *cleaner: pointer to the cleaner, set to NULL
+ * Return: none
+ * Expects
+ * - cleaner and *cleaner to be non-null
+************************/
+void Cleaner_free(T *cleaner) {
+        assert(cleaner != NULL && *cleaner != NULL);
+        Pool_free(&(*cleaner)->pool);
+        free(*cleaner);
+        *cleaner = NULL;
+}
+
+/**********cleanerRead********
+ * About: This function reads the pbm file held in a buffer into a bitmap
+ *        with pbmReadBuffer and turns what it found into a status
+ * Inputs:
+ * const unsigned char *data: the bytes of a plain or raw pbm file
+ * size_t length: the number of bytes in data
+ * Bit2_T bitmap: the BIT2_ROWS bitmap the image is stored in
+ * Return: CLEANER_OK, CLEANER_BAD_INPUT or CLEANER_NO_MEMORY
+************************/
+Cleaner_Status cleanerRead(const unsigned char *data, size_t length,
+                           Bit2_T bitmap) {
+        switch (pbmReadBuffer(data, length, bitmap)) {
+        case PBM_READ_OK:
+                return CLEANER_OK;
+        case PBM_READ_BAD:
+                return CLEANER_BAD_INPUT;
+        default:
+                return CLEANER_NO_MEMORY;
+        }
+}
+
+/**********cleanerClear********
+ * About: This function clears the black edges of a bitmap with the engine
+ *        of a cleaner, taking the stack of the engine from the pool of the
+ *        cleaner
+ * Inputs:
+ * T cleaner: the cleaner, whose pool was reset for this image
+ * Bit2_T bitmap: the BIT2_ROWS bitmap holding the image
+ * Return: CLEANER_OK, or CLEANER_NO_MEMORY if the pool ran out of memory
+************************/
+Cleaner_Status cleanerClear(T cleaner, Bit2_T bitmap) {
+        Frontier_T stack = Frontier_new_pool(CLEANER_STACK_HINT,
+                                             cleaner->pool);
+        if (stack == NULL || !engineClearEdges(cleaner->engine, bitmap, stack,
+                                               cleaner->pool,
+                                               cleaner->threads)) {
+                return CLEANER_NO_MEMORY;
+        }
+        return CLEANER_OK;
+}
+
+#undef T
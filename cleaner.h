@@ -0,0 +1,51 @@
+/*
+ *     cleaner.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to clean the black edges of pbm files
+ *     held in memory from a program linked with libunblackedges, instead of
+ *     running unblackedges once per image. A cleaner keeps a pool for the
+ *     bitmap, the stack and the arrays of its engine, so a thread cleaning
+ *     one image after another stops allocating once the largest image has
+ *     been seen. Cleaners share no state, so threads that each use their
+ *     own cleaner need no locking; the tiled engine spreads a single image
+ *     over the processors instead. Bad arguments, bad files and running out
+ *     of memory are reported by the returned status. No exception is
+ *     raised and nothing taken for an image is left behind when it fails.
+ *
+ */
+
+#ifndef CLEANER_INCLUDED
+#define CLEANER_INCLUDED
+
+#include <stdlib.h>
+#include <bit2.h>
+#include <clearEngine.h>
+#include <pbmReadWrite.h>
+
+#define T Cleaner_T
+typedef struct T *T;
+
+/* what cleaning an image came to */
+typedef enum {
+        CLEANER_OK = 0, /* the image was cleaned */
+        CLEANER_BAD_ARGUMENT, /* a null pointer, or an unknown format */
+        CLEANER_BAD_INPUT, /* the buffer does not hold a pbm file */
+        CLEANER_SHORT_BUFFER, /* the cleaned file does not fit the buffer */
+        CLEANER_NO_MEMORY /* an allocation failed */
+} Cleaner_Status;
+
+extern T Cleaner_new(Engine engine, int threads);
+extern Cleaner_Status Cleaner_clean(T cleaner, const unsigned char *data,
+                                    size_t length, Bit2_T bitmap);
+extern Cleaner_Status Cleaner_clean_buffer(T cleaner,
+                                           const unsigned char *data,
+                                           size_t length, int format,
+                                           unsigned char *out,
+                                           size_t capacity, size_t *written);
+extern const char *Cleaner_message(Cleaner_Status status);
+extern void Cleaner_free(T *cleaner);
+
+#undef T
+#endif
@@ -0,0 +1,99 @@
+/*
+ *     clearEngine.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file maps the names of the edge clearing engines to the
+ *     engines and runs the one that was picked.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <pool.h>
+#include <dfsClear.h>
+#include <spanFill.h>
+#include <morphClear.h>
+#include <tiledClear.h>
+#include <labelClear.h>
+#include <clearEngine.h>
+
+/* the name of each engine, in the order of the Engine enum */
+static const char *engineNames[ENGINE_COUNT] = {
+        "dfs", "span", "morph", "tiled", "label"
+};
+
+/**********engineParse********
+ * About: This function finds the engine with the given name
+ * Inputs:
+ * const char *name: the name of the engine
+ * Engine *engine: pointer to where the engine is stored
+ * Return: true if there is an engine with the name, false otherwise
+ * Expects
+ * - name and engine to be non-null
+************************/
+bool engineParse(const char *name, Engine *engine) {
+        assert(name != NULL && engine != NULL);
+
+        for (int i = 0; i < ENGINE_COUNT; i++) {
+                if (strcmp(name, engineNames[i]) == 0) {
+                        *engine = (Engine)i;
+                        return true;
+                }
+        }
+        return false;
+}
+
+/**********engineName********
+ * About: This function returns the name of an engine
+ * Inputs:
+ * Engine engine: the engine
+ * Return: the name of the engine
+************************/
+const char *engineName(Engine engine) {
+        assert((int)engine >= 0 && (int)engine < ENGINE_COUNT);
+        return engineNames[engine];
+}
+
+/**********engineClearEdges********
+ * About: This function clears the black edges of the bitmap with the given
+ * engine
+ * Inputs:
+ * Engine engine: the engine to run
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * Frontier_T stack: an empty stack for the engines that use one (dfs and
+ *                   span)
+ * Pool_T pool: the pool the other engines take their arrays from, which
+ *              keeps them until the caller resets it
+ * int threads: the number of threads for the tiled engine, 0 (or less) for
+ *              one per online processor
+ * Return: true if the edges were cleared, false if the pool (or the pool of
+ *         the stack) ran out of memory. The engines that take their arrays
+ *         up front leave the bitmap unchanged then, while dfs and span may
+ *         have cleared part of the edges.
+ * Expects
+ * - bitmap, stack and pool to be non-null
+************************/
+bool engineClearEdges(Engine engine, Bit2_T bitmap, Frontier_T stack,
+                      Pool_T pool, int threads) {
+        assert(bitmap != NULL && stack != NULL && pool != NULL);
+
+        switch (engine) {
+        case ENGINE_SPAN:
+                spanClearEdges(bitmap, stack);
+                return !Frontier_failed(stack);
+        case ENGINE_MORPH:
+                return morphClearEdges(bitmap, pool) > 0;
+        case ENGINE_TILED:
+                return tiledClearEdges(bitmap, threads, pool);
+        case ENGINE_LABEL:
+                return labelClearEdges(bitmap, pool);
+        default:
+                dfsClearEdges(bitmap, stack);
+                return !Frontier_failed(stack);
+        }
+}
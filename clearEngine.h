@@ -0,0 +1,35 @@
+/*
+ *     clearEngine.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file lists the engines that can clear the black edges of a
+ *     Bit2_T bitmap, and lets a client pick one by name and run it. The
+ *     arrays an engine needs for one image are taken from a Pool_T of the
+ *     client, so a client that resets the pool between images stops
+ *     allocating once the largest image has been seen. An engine that runs
+ *     out of pool memory reports it instead of raising an exception.
+ *
+ */
+
+#ifndef CLEARENGINE_INCLUDED
+#define CLEARENGINE_INCLUDED
+
+#include <stdbool.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <pool.h>
+
+/* the engines that can be selected to clear the black edges */
+typedef enum {
+        ENGINE_DFS, ENGINE_SPAN, ENGINE_MORPH, ENGINE_TILED, ENGINE_LABEL
+} Engine;
+
+#define ENGINE_COUNT 5
+
+extern bool engineParse(const char *name, Engine *engine);
+extern const char *engineName(Engine engine);
+extern bool engineClearEdges(Engine engine, Bit2_T bitmap, Frontier_T stack,
+                             Pool_T pool, int threads);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ *     dfsClear.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file clears the black edges of a Bit2_T bitmap one bit at
+ *     a time. Black edge bits are defined as pixels with value 1 and located
+ *     at the edges, or pixels with value 1 and a neighbour that is a black
+ *     edge pixel. Every black edge bit is made white and pushed to a stack,
+ *     and the bits on the stack are visited depth first until none of them
+ *     has a black neighbour left.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <dfsClear.h>
+
+/* function declarations */
+void seedRow(int row, Bit2_word *span, int words, Bit2_T array, void *p1);
+void clearEdges(int col, int row, Bit2_T array, int bit, void *p1);
+bool stackHandler(int col1, int row1, Bit2_T array, void *p1);
+
+/**********dfsClearEdges********
+ * About: This function visits only the edge bits of the 2D bit vector and
+ * calls clearEdges on each black one. BIT2_ROWS bitmaps are scanned a row
+ * at a time with seedRow.
+ * Inputs:
+ * Bit2_T array: 2D bit vector storing the bit values
+ * Frontier_T stack: the stack used to store bit location information
+ * Expects
+ * - array to be non-null, which is handled by Bit2_new function
+ * - stack to be non-null, which is handled by Frontier_new function
+************************/
+void dfsClearEdges(Bit2_T array, Frontier_T stack) {
+        int width = Bit2_width(array);
+        int height = Bit2_height(array);
+        int lastCol = width - 1;
+
+        /* blocked bitmaps have no row spans, so their edges are read bit by
+         * bit; the fill itself then stays inside 8x8 blocks */
+        if (Bit2_layout(array) == BIT2_BLOCKED) {
+                for (int row = 0; row < height; row++) {
+                        int step = (row == 0 || row == height - 1) ? 1 :
+                                   (lastCol > 0 ? lastCol : 1);
+                        for (int col = 0; col < width; col += step) {
+                                clearEdges(col, row, array,
+                                           Bit2_get_unchecked(array, col,
+                                                              row), stack);
+                        }
+                }
+                return;
+        }
+
+        Bit2_map_rows(array, seedRow, stack);
+}
+
+/**********seedRow********
+ * About: This function is an apply function for Bit2_map_rows that calls
+ * clearEdges on the black edge bits of one row. The first and last rows are
+ * scanned a word at a time so that white stretches of 64 bits are skipped
+ * at once; the rows in between only have edge bits in their two end cols.
+ * Inputs:
+ * int row: the index of the row
+ * Bit2_word *span: the words of the row
+ * int words: the number of words in span
+ * Bit2_T array: 2D bit vector storing the bit values
+ * void *p1: the stack used to store bit location information
+ * Return: none
+************************/
+void seedRow(int row, Bit2_word *span, int words, Bit2_T array, void *p1) {
+        int lastCol = Bit2_width(array) - 1;
+
+        if (row != 0 && row != Bit2_height(array) - 1) {
+                if (span[0] & 1) {
+                        clearEdges(0, row, array, 1, p1);
+                }
+                if ((span[lastCol / BIT2_WORD_BITS] >>
+                     (lastCol % BIT2_WORD_BITS)) & 1) {
+                        clearEdges(lastCol, row, array, 1, p1);
+                }
+                return;
+        }
+        for (int w = 0; w < words; w++) {
+                for (int b = 0; b < BIT2_WORD_BITS; b++) {
+                        /* re-reading since clearEdges may clear it */
+                        Bit2_word word = span[w] >> b;
+                        if (word == 0) {
+                                break;
+                        }
+                        if (word & 1) {
+                                clearEdges(w * BIT2_WORD_BITS + b, row,
+                                           array, 1, p1);
+                        }
+                }
+        }
+}
+
+/**********clearEdges********
+ * About: This function is called by dfsClearEdges on every edge bit, and has
+ * the shape of a Bit2_map_row_major apply function. It updates the bit
+ * values such that there are no black edge bits or black bits that are
+ * neighbours to black edges.
+ * Inputs:
+ * int col: column index of the bit being visited
+ * int row: row index of the bit being visited
+ * Bit2_T array: 2D bit vector storing the bit values
+ * int bit: value of the current bit being visited 
+ * int *p1: pointer to the stack used to store bit location information 
+ * Expects
+ * - array to be non-null, which is handled by Bit2_new function
+ * - *p1 to be non-null, which is handled by Frontier_new function
+ * - bit to be 0 or 1, which is a requirement of the pbm file and checked by
+ * Pnmrdr interface
+************************/
+void clearEdges(int col, int row, Bit2_T array, int bit, void *p1) {
+        /* if the bit is white, no need to unblack */
+        if (bit == 0) 
+                return;
+        /* if the bit is not an edge bit, we skip */
+        if (col != 0 && row != 0 && col != Bit2_width(array) - 1 &&
+            row != Bit2_height(array) - 1) {
+                return;
+        }
+        /* making the bit white after adding it to the stack */
+        Frontier_push(p1, col, row);
+        Bit2_put_unchecked(array, col, row, 0);
+       
+        /* while stack not empty, get top element and check its neighbors */
+        while (Frontier_length(p1) != 0) {
+                int col1, row1;
+                Frontier_top(p1, &col1, &row1);
+
+                bool hasBlackNeighbor = stackHandler(col1, row1, array, p1);
+                /* if bit has no black neighbors, remove bit from stack */
+                if (!hasBlackNeighbor) {
+                        Frontier_pop(p1, &col1, &row1);
+                }
+        }  
+}
+
+/**********stackHandler********
+ * About: This function is used to see if the neighbors of the bit at 
+ * [col1, row1] are black, and if they are, the function pushes their location
+ * to the stack. 
+ * Inputs:
+ * int col1: column index of the bit being visited
+ * int row1: row index of the bit being visited
+ * Bit2_T array: 2D bit vector storing the bit values
+ * int *p1: pointer to the stack used to store bit location information 
+ * Returns: true if the current bit has any black neighbors, and false 
+ * otherwise
+ * Expects
+ * - array to be non-null, which is handled by Bit2_new function
+ * - *p1 to be non-null, which is handled by Frontier_new function
+************************/
+bool stackHandler(int col1, int row1, Bit2_T array, void *p1) {
+        bool hasBlackNeighbor = false;
+
+        /* checking neighbors of the bit being visited and inserting the  
+         * location info to the stack if the neighbor is black; the indices
+         * are checked here, so the unchecked accessors are used */
+        if (col1 != 0 &&
+            Bit2_get_unchecked(array, col1 - 1, row1) == 1) {
+                Frontier_push(p1, col1 - 1, row1);
+                Bit2_put_unchecked(array, col1 - 1, row1, 0);
+                hasBlackNeighbor = true;       
+        }
+        else if (row1 != 0 &&
+                 Bit2_get_unchecked(array, col1, row1 - 1) == 1) {
+                Frontier_push(p1, col1, row1 - 1);
+                Bit2_put_unchecked(array, col1, row1 - 1, 0);
+                hasBlackNeighbor = true;      
+        }
+        else if (col1 != Bit2_width(array) - 1 && 
+                 Bit2_get_unchecked(array, col1 + 1, row1) == 1) {
+                Frontier_push(p1, col1 + 1, row1);
+                Bit2_put_unchecked(array, col1 + 1, row1, 0);
+                hasBlackNeighbor = true;
+        }
+        else if (row1 != Bit2_height(array) - 1 && 
+                 Bit2_get_unchecked(array, col1, row1 + 1) == 1) {
+                Frontier_push(p1, col1, row1 + 1);
+                Bit2_put_unchecked(array, col1, row1 + 1, 0);
+                hasBlackNeighbor = true;
+        }
+        return hasBlackNeighbor;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+/*
+ *     dfsClear.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds the depth-first edge clearing engine. Starting
+ *     from every black bit on an edge of a Bit2_T bitmap, it makes black
+ *     bits white one at a time, following black neighbours with a stack.
+ *
+ */
+
+#ifndef DFSCLEAR_INCLUDED
+#define DFSCLEAR_INCLUDED
+
+#include <bit2.h>
+#include <frontier.h>
+
+extern void dfsClearEdges(Bit2_T array, Frontier_T stack);
+
+#endif
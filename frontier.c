@@ -0,0 +1,294 @@
+/*
+ *     frontier.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file is used to create a stack of bit locations where each
+ *     (col, row) pair is packed into one 64-bit integer, with the row in the
+ *     upper half and the col in the lower half. The entries are stored in a
+ *     contiguous array that doubles in size when it runs out of room, and
+ *     the largest length and capacity reached are tracked so that the peak
+ *     memory can be reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <string.h>
+#include <mem.h>
+#include <pool.h>
+#include <frontier.h>
+
+#define T Frontier_T
+
+/**********struct T********
+ * About: This struct holds the packed locations of the stack and the
+ *        information needed to grow it and report its peak size.
+************************/
+struct T {
+        long length; /* number of locations on the stack */
+        long capacity; /* number of locations that fit before growing */
+        long peak; /* largest length the stack has reached */
+        int allocations; /* number of times entries was (re)allocated */
+        long retained; /* bytes of the outgrown arrays left in the pool */
+        bool failed; /* true once the pool had no room for a push */
+        uint64_t *entries; /* packed locations, the top is the last one */
+        Pool_T pool; /* the pool the stack lives in, or NULL for Mem */
+};
+
+/**********Frontier_new********
+ * About: This function creates an empty stack with room for hint locations
+ * Inputs:
+ * int hint: number of locations to make room for, at least 1
+ * Return: an empty stack
+ * Expects
+ * - hint to be greater than 0
+************************/
+T Frontier_new(int hint) {
+        return Frontier_new_pool(hint, NULL);
+}
+
+/**********Frontier_new_pool********
+ * About: This function creates an empty stack like Frontier_new, taking its
+ * memory from the given pool. When such a stack grows, the larger array is
+ * taken from the pool too and the old one stays there until the pool is
+ * reset, which at most doubles the memory of the stack.
+ * Inputs:
+ * int hint: number of locations to make room for, at least 1
+ * Pool_T pool: the pool, or NULL to allocate with Mem like Frontier_new
+ * Return: an empty stack, or NULL if the pool ran out of memory
+ * Expects
+ * - hint to be greater than 0
+************************/
+T Frontier_new_pool(int hint, Pool_T pool) {
+        assert(hint > 0);
+
+        T frontier;
+        if (pool != NULL) {
+                frontier = Pool_alloc(pool, (long)sizeof(*frontier));
+                if (frontier == NULL) {
+                        return NULL;
+                }
+                frontier->entries = Pool_alloc(pool, (long)hint *
+                                               sizeof(uint64_t));
+                if (frontier->entries == NULL) {
+                        return NULL;
+                }
+        }
+        else {
+                NEW(frontier);
+                frontier->entries = ALLOC((long)hint * sizeof(uint64_t));
+        }
+        frontier->pool = pool;
+        frontier->length = 0;
+        frontier->capacity = hint;
+        frontier->peak = 0;
+        frontier->allocations = 1;
+        frontier->retained = 0;
+        frontier->failed = false;
+        return frontier;
+}
+
+/**********Frontier_length********
+ * About: This function returns the number of locations on the stack
+ * Inputs:
+ * T frontier: the stack
+ * Return: the number of locations on the stack
+ * Expects
+ * - frontier to be non-null
+************************/
+long Frontier_length(T frontier) {
+        assert(frontier != NULL);
+        return frontier->length;
+}
+
+/**********Frontier_push********
+ * About: This function packs the given location and pushes it to the top of
+ * the stack, doubling the array when it is full. If the pool of the stack
+ * has no room for the larger array, the location is dropped and the stack
+ * is marked as failed.
+ * Inputs:
+ * T frontier: the stack
+ * int col: column index of the location, at least 0
+ * int row: row index of the location, at least 0
+ * Return: none
+ * Expects
+ * - frontier to be non-null
+ * - col and row to be at least 0
+************************/
+void Frontier_push(T frontier, int col, int row) {
+        assert(frontier != NULL);
+        assert(col >= 0 && row >= 0);
+
+        if (frontier->length == frontier->capacity) {
+                /* the capacity is only doubled once the entries are
+                   allocated, so the stack stays whole if it raises */
+                long capacity = frontier->capacity * 2;
+                long bytes = capacity * (long)sizeof(uint64_t);
+                if (frontier->pool != NULL) {
+                        uint64_t *entries = Pool_alloc(frontier->pool, bytes);
+                        if (entries == NULL) {
+                                frontier->failed = true;
+                                return;
+                        }
+                        memcpy(entries, frontier->entries,
+                               frontier->length * sizeof(uint64_t));
+                        frontier->entries = entries;
+                        frontier->retained += frontier->capacity *
+                                              (long)sizeof(uint64_t);
+                }
+                else {
+                        RESIZE(frontier->entries, bytes);
+                }
+                frontier->capacity = capacity;
+                frontier->allocations++;
+        }
+        frontier->entries[frontier->length++] = (uint64_t)row << 32 |
+                                                (uint32_t)col;
+        if (frontier->length > frontier->peak) {
+                frontier->peak = frontier->length;
+        }
+}
+
+/**********Frontier_top********
+ * About: This function unpacks the location at the top of the stack without
+ * removing it
+ * Inputs:
+ * T frontier: the stack
+ * int *col: pointer to where the column index is stored
+ * int *row: pointer to where the row index is stored
+ * Return: none
+ * Expects
+ * - frontier, col and row to be non-null
+ * - the stack to be non-empty
+************************/
+void Frontier_top(T frontier, int *col, int *row) {
+        assert(frontier != NULL && col != NULL && row != NULL);
+        assert(frontier->length > 0);
+
+        uint64_t entry = frontier->entries[frontier->length - 1];
+        *col = (int)(entry & UINT32_MAX);
+        *row = (int)(entry >> 32);
+}
+
+/**********Frontier_pop********
+ * About: This function removes the location at the top of the stack and
+ * unpacks it
+ * Inputs:
+ * T frontier: the stack
+ * int *col: pointer to where the column index is stored
+ * int *row: pointer to where the row index is stored
+ * Return: true if a location was removed, false if the stack was empty
+ * Expects
+ * - frontier, col and row to be non-null
+************************/
+bool Frontier_pop(T frontier, int *col, int *row) {
+        assert(frontier != NULL && col != NULL && row != NULL);
+
+        if (frontier->length == 0) {
+                return false;
+        }
+        Frontier_top(frontier, col, row);
+        frontier->length--;
+        return true;
+}
+
+/**********Frontier_failed********
+ * About: This function tells if a push was ever dropped because the pool of
+ * the stack ran out of memory, in which case a flood fill using the stack
+ * did not reach every bit it should have
+ * Inputs:
+ * T frontier: the stack
+ * Return: true if a push was dropped, false otherwise
+ * Expects
+ * - frontier to be non-null
+************************/
+bool Frontier_failed(T frontier) {
+        assert(frontier != NULL);
+        return frontier->failed;
+}
+
+/**********Frontier_peak********
+ * About: This function returns the largest number of locations that were on
+ * the stack at the same time
+ * Inputs:
+ * T frontier: the stack
+ * Return: the peak length of the stack
+ * Expects
+ * - frontier to be non-null
+************************/
+long Frontier_peak(T frontier) {
+        assert(frontier != NULL);
+        return frontier->peak;
+}
+
+/**********Frontier_peak_bytes********
+ * About: This function returns the number of bytes held by the stack at its
+ * largest, which is the size of the array since it never shrinks, plus the
+ * smaller arrays a stack made by Frontier_new_pool left in its pool
+ * Inputs:
+ * T frontier: the stack
+ * Return: the peak memory used by the stack in bytes
+ * Expects
+ * - frontier to be non-null
+************************/
+long Frontier_peak_bytes(T frontier) {
+        assert(frontier != NULL);
+        return (long)sizeof(*frontier) +
+               frontier->capacity * (long)sizeof(uint64_t) +
+               frontier->retained;
+}
+
+/**********Frontier_allocations********
+ * About: This function returns the number of times the array of the stack
+ * was allocated or grown, since it was created or its statistics were reset
+ * Inputs:
+ * T frontier: the stack
+ * Return: the number of allocations
+ * Expects
+ * - frontier to be non-null
+************************/
+int Frontier_allocations(T frontier) {
+        assert(frontier != NULL);
+        return frontier->allocations;
+}
+
+/**********Frontier_reset_stats********
+ * About: This function starts the peak length and the allocation count of
+ * the stack over, so a stack reused for many images can report them for
+ * each image. The peak starts again from the current length.
+ * Inputs:
+ * T frontier: the stack
+ * Return: none
+ * Expects
+ * - frontier to be non-null
+************************/
+void Frontier_reset_stats(T frontier) {
+        assert(frontier != NULL);
+        frontier->peak = frontier->length;
+        frontier->allocations = 0;
+}
+
+/**********Frontier_free********
+ * About: This function frees the memory allocated to the stack. The memory
+ * of a stack made by Frontier_new_pool stays in its pool until the pool is
+ * reset.
+ * Inputs:
+ * T *frontier: address of the stack
+ * Return: none
+ * Expects
+ * - frontier and *frontier to be non-null
+************************/
+void Frontier_free(T *frontier) {
+        assert(frontier != NULL && *frontier != NULL);
+
+        if ((*frontier)->pool != NULL) {
+                *frontier = NULL;
+                return;
+        }
+        FREE((*frontier)->entries);
+        FREE(*frontier);
+}
+
+#undef T
@@ -0,0 +1,42 @@
+/*
+ *     frontier.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to create a stack of bit locations for
+ *     the flood fills that clear black edges. Each location is packed into a
+ *     single integer and all of them live in one contiguous array that
+ *     doubles when it is full, so pushing and popping does no heap traffic
+ *     of its own. The largest size the stack ever reached, and how often it
+ *     had to grow, can be reported. A stack can take its memory from a
+ *     Pool_T, in which case resetting the pool frees it; the arrays it
+ *     outgrew stay in the pool until then and count towards its peak
+ *     bytes. Such a stack does not raise Mem_Failed: a push the pool has
+ *     no room for is dropped and the stack remembers that it failed.
+ *
+ */
+
+#ifndef FRONTIER_INCLUDED
+#define FRONTIER_INCLUDED
+
+#include <stdbool.h>
+#include <pool.h>
+
+#define T Frontier_T
+typedef struct T *T;
+
+extern T Frontier_new(int hint);
+extern T Frontier_new_pool(int hint, Pool_T pool);
+extern long Frontier_length(T frontier);
+extern void Frontier_push(T frontier, int col, int row);
+extern void Frontier_top(T frontier, int *col, int *row);
+extern bool Frontier_pop(T frontier, int *col, int *row);
+extern bool Frontier_failed(T frontier);
+extern long Frontier_peak(T frontier);
+extern long Frontier_peak_bytes(T frontier);
+extern int Frontier_allocations(T frontier);
+extern void Frontier_reset_stats(T frontier);
+extern void Frontier_free(T *frontier);
+
+#undef T
+#endif
@@ -0,0 +1,183 @@
+/*
+ *     incrementalClear.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file clears the black edges of an edited image using the
+ *     result of cleaning the image before it was edited. A black bit keeps
+ *     its previous result unless its component in the old or in the new
+ *     image holds a bit that changed: otherwise both components are the
+ *     same set of bits, so it reached an edge before exactly when it
+ *     reaches one now. The components that do hold a changed bit, in either
+ *     image, are found with span fills seeded from the changed bits and
+ *     are cleared again on their own, so apart from a few passes over the
+ *     words of the rows the work grows with the size of the edit instead of
+ *     the size of the image.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <mem.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <spanFill.h>
+#include <incrementalClear.h>
+
+/* function declarations */
+bool incrementalSameShape(Bit2_T bitmap1, Bit2_T bitmap2);
+void incrementalRecompute(Bit2_T prevIn, Bit2_T prevOut, Bit2_T bitmap,
+                          const bool *changed, Frontier_T seeds);
+
+/**********incrementalClearEdges********
+ * About: This function clears every black bit of bitmap that is connected
+ * to an edge, reusing prevOut for the components the edit from prevIn to
+ * bitmap cannot reach. It gives up, leaving bitmap unchanged, when the
+ * bitmaps do not have the same size, when prevOut is not prevIn with some
+ * bits cleared, or when so many rows changed that a full clear is cheaper.
+ * Otherwise prevIn is used as scratch space and holds no useful bits when
+ * it returns.
+ * Inputs:
+ * Bit2_T prevIn: the image before it was edited
+ * Bit2_T prevOut: prevIn with its black edges cleared
+ * Bit2_T bitmap: the edited image, which becomes its cleared version
+ * Frontier_T seeds: an empty stack used to store the seeds
+ * Return: true if bitmap was cleared, false if the caller has to clear it
+ *         with a full engine instead
+ * Expects
+ * - all arguments to be non-null
+************************/
+bool incrementalClearEdges(Bit2_T prevIn, Bit2_T prevOut, Bit2_T bitmap,
+                           Frontier_T seeds) {
+        assert(prevIn != NULL && prevOut != NULL && bitmap != NULL);
+        assert(seeds != NULL);
+
+        if (!incrementalSameShape(prevIn, bitmap) ||
+            !incrementalSameShape(prevOut, bitmap)) {
+                return false;
+        }
+
+        /* finding the changed rows and checking prevOut only clears bits */
+        int height = Bit2_height(bitmap);
+        int words = Bit2_row_words(bitmap);
+        size_t bytes = words * sizeof(Bit2_word);
+        bool *changed = CALLOC(height, sizeof(bool));
+        int changedRows = 0;
+        bool consistent = true;
+        for (int i = 0; i < height && consistent; i++) {
+                const Bit2_word *before = Bit2_row(prevIn, i);
+                const Bit2_word *after = Bit2_row(prevOut, i);
+                for (int w = 0; w < words; w++) {
+                        if ((after[w] & ~before[w]) != 0) {
+                                consistent = false;
+                        }
+                }
+                changed[i] = memcmp(before, Bit2_row(bitmap, i), bytes) != 0;
+                changedRows += changed[i];
+        }
+
+        bool cleared = consistent &&
+                       changedRows * INCREMENTAL_MAX_SHARE <= height;
+        if (cleared && changedRows == 0) {
+                for (int i = 0; i < height; i++) {
+                        memcpy(Bit2_row_mut(bitmap, i), Bit2_row(prevOut, i),
+                               bytes);
+                }
+        }
+        else if (cleared) {
+                incrementalRecompute(prevIn, prevOut, bitmap, changed, seeds);
+        }
+        FREE(changed);
+        return cleared;
+}
+
+/**********incrementalSameShape********
+ * About: This function checks that two bitmaps can be compared a row span
+ * at a time
+ * Inputs:
+ * Bit2_T bitmap1: the first bitmap
+ * Bit2_T bitmap2: the second bitmap
+ * Return: true if both are stored in rows and have the same size
+************************/
+bool incrementalSameShape(Bit2_T bitmap1, Bit2_T bitmap2) {
+        return Bit2_layout(bitmap1) == BIT2_ROWS &&
+               Bit2_layout(bitmap2) == BIT2_ROWS &&
+               Bit2_width(bitmap1) == Bit2_width(bitmap2) &&
+               Bit2_height(bitmap1) == Bit2_height(bitmap2);
+}
+
+/**********incrementalRecompute********
+ * About: This function clears bitmap from the previous result and the
+ * changed rows. The old components holding a bit that turned white are
+ * filled away in prevIn. Every new component holding a black bit that is
+ * not left in prevIn, so a bit that turned black or a bit of a filled old
+ * component, is then filled away in bitmap itself, after prevIn gets the
+ * rows of bitmap. The filled bits are whole components that are cleared on
+ * their own, and every bit left in bitmap takes its result from prevOut.
+ * Inputs:
+ * Bit2_T prevIn: the image before it was edited, used up as scratch space
+ * Bit2_T prevOut: prevIn with its black edges cleared
+ * Bit2_T bitmap: the edited image, which becomes its cleared version
+ * const bool *changed: for every row, true if it differs from prevIn
+ * Frontier_T seeds: an empty stack used to store the seeds
+ * Return: none
+************************/
+void incrementalRecompute(Bit2_T prevIn, Bit2_T prevOut, Bit2_T bitmap,
+                          const bool *changed, Frontier_T seeds) {
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        int words = Bit2_row_words(bitmap);
+        Bit2_word *turned = ALLOC(words * sizeof(Bit2_word));
+
+        /* filling away the old components of the bits that turned white */
+        for (int i = 0; i < height; i++) {
+                if (changed[i]) {
+                        const Bit2_word *old = Bit2_row(prevIn, i);
+                        const Bit2_word *now = Bit2_row(bitmap, i);
+                        for (int w = 0; w < words; w++) {
+                                turned[w] = old[w] & ~now[w];
+                        }
+                        spanSeedRuns(turned, 0, width - 1, i, seeds);
+                }
+        }
+        spanFill(prevIn, seeds);
+
+        /* seeding the new fill from the black bits missing from prevIn */
+        for (int i = 0; i < height; i++) {
+                Bit2_word *span = Bit2_row_mut(prevIn, i);
+                const Bit2_word *now = Bit2_row(bitmap, i);
+                Bit2_word any = 0;
+                for (int w = 0; w < words; w++) {
+                        turned[w] = now[w] & ~span[w];
+                        any |= turned[w];
+                }
+                if (any != 0) {
+                        spanSeedRuns(turned, 0, width - 1, i, seeds);
+                }
+                memcpy(span, now, words * sizeof(Bit2_word));
+        }
+        spanFill(bitmap, seeds);
+        FREE(turned);
+
+        /* clearing the edges of the filled components on their own */
+        for (int i = 0; i < height; i++) {
+                Bit2_word *span = Bit2_row_mut(prevIn, i);
+                const Bit2_word *left = Bit2_row(bitmap, i);
+                for (int w = 0; w < words; w++) {
+                        span[w] &= ~left[w];
+                }
+        }
+        spanClearEdges(prevIn, seeds);
+
+        /* the bits left in bitmap kept their components, and their result */
+        for (int i = 0; i < height; i++) {
+                Bit2_word *span = Bit2_row_mut(bitmap, i);
+                const Bit2_word *kept = Bit2_row(prevIn, i);
+                const Bit2_word *result = Bit2_row(prevOut, i);
+                for (int w = 0; w < words; w++) {
+                        span[w] = kept[w] | (result[w] & span[w]);
+                }
+        }
+}
@@ -0,0 +1,26 @@
+/*
+ *     incrementalClear.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds an edge clearing function for an image that was
+ *     cleaned before and then edited. Given the previous input and output,
+ *     only the black components that the changed rows can reach are cleared
+ *     again, and the rest of the output is taken from the previous output.
+ *
+ */
+
+#ifndef INCREMENTALCLEAR_INCLUDED
+#define INCREMENTALCLEAR_INCLUDED
+
+#include <stdbool.h>
+#include <bit2.h>
+#include <frontier.h>
+
+/* more than one changed row in this many makes a full clear cheaper */
+#define INCREMENTAL_MAX_SHARE 4
+
+extern bool incrementalClearEdges(Bit2_T prevIn, Bit2_T prevOut,
+                                  Bit2_T bitmap, Frontier_T seeds);
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ *     labelClear.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file clears the black edges of a Bit2_T bitmap with two
+ *     passes in raster order. The first pass labels every black run with
+ *     RunLabels, joining runs that touch in neighbouring rows in a
+ *     union-find forest. The roots of the runs on the edges of the image are
+ *     then marked, and the second pass clears every run whose root is
+ *     marked. Both passes read the rows from top to bottom and each row from
+ *     left to right, so unlike the flood fills no bit is ever probed out of
+ *     order. The labels and marks are taken from a pool given by the
+ *     caller.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <bit2.h>
+#include <pool.h>
+#include <spanFill.h>
+#include <runLabel.h>
+#include <labelClear.h>
+
+/**********labelClearEdges********
+ * About: This function clears every black bit that is connected to an edge
+ * of the bitmap
+ * Inputs:
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * Pool_T pool: the pool the labels are taken from, which keeps them until
+ *              the caller resets it
+ * Return: true if the edges were cleared, false if the pool ran out of
+ *         memory, leaving the bitmap unchanged
+ * Expects
+ * - bitmap to be non-null and stored in BIT2_ROWS
+ * - pool to be non-null
+************************/
+bool labelClearEdges(Bit2_T bitmap, Pool_T pool) {
+        assert(bitmap != NULL && pool != NULL);
+
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        RunLabels labels;
+        if (!RunLabels_init(&labels, bitmap, 0, height, pool)) {
+                return false;
+        }
+        if (labels.length == 0) {
+                return true;
+        }
+
+        /* every run of the first and last rows is on an edge */
+        unsigned char *onEdge = Pool_calloc(pool, labels.length, 1);
+        if (onEdge == NULL) {
+                return false;
+        }
+        for (long run = labels.rowStart[0]; run < labels.rowStart[1]; run++) {
+                onEdge[RunLabels_find(labels.parent, run)] = 1;
+        }
+        for (long run = labels.rowStart[height - 1];
+             run < labels.rowStart[height]; run++) {
+                onEdge[RunLabels_find(labels.parent, run)] = 1;
+        }
+
+        /* only the first and last run of a row can reach the side edges */
+        for (int i = 0; i < height; i++) {
+                long first = labels.rowStart[i];
+                long last = labels.rowStart[i + 1] - 1;
+                if (first > last) {
+                        continue;
+                }
+                if (labels.first[first] == 0) {
+                        onEdge[RunLabels_find(labels.parent, first)] = 1;
+                }
+                if (labels.last[last] == width - 1) {
+                        onEdge[RunLabels_find(labels.parent, last)] = 1;
+                }
+        }
+
+        /* the second pass, clearing the runs of marked components */
+        for (int i = 0; i < height; i++) {
+                Bit2_word *span = Bit2_row_mut(bitmap, i);
+                for (long run = labels.rowStart[i];
+                     run < labels.rowStart[i + 1]; run++) {
+                        if (onEdge[RunLabels_find(labels.parent, run)]) {
+                                spanClearRange(span, labels.first[run],
+                                               labels.last[run]);
+                        }
+                }
+        }
+        return true;
+}
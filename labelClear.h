@@ -0,0 +1,22 @@
+/*
+ *     labelClear.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds an edge clearing engine based on two pass
+ *     connected component labelling. The black runs of a Bit2_T bitmap are
+ *     labelled in raster order, and the components that reach an edge are
+ *     cleared in a second sweep over the rows.
+ *
+ */
+
+#ifndef LABELCLEAR_INCLUDED
+#define LABELCLEAR_INCLUDED
+
+#include <stdbool.h>
+#include <bit2.h>
+#include <pool.h>
+
+extern bool labelClearEdges(Bit2_T bitmap, Pool_T pool);
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ *     morphClear.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file clears the black edges of a Bit2_T bitmap with
+ *     morphological reconstruction. A marker bitmap starts as the black bits
+ *     on the edges of the image. Sweeps over the rows, alternating between
+ *     top to bottom and bottom to top, grow the marker into the black bits
+ *     of the rows next to it and then along every black run of the row,
+ *     using only shifts, adds, ands and ors on whole words. Once a sweep
+ *     changes nothing, the marker holds exactly the black edge bits and is
+ *     removed from the image. The marker is taken from a pool given by the
+ *     caller.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <bit2.h>
+#include <pool.h>
+#include <morphClear.h>
+
+/* function declarations */
+bool morphSweep(Bit2_T bitmap, Bit2_word *marker, bool down);
+void morphFillRow(Bit2_word *marker, const Bit2_word *image, int words);
+Bit2_word morphReverse(Bit2_word word);
+
+/**********morphClearEdges********
+ * About: This function clears every black bit that is connected to an edge
+ * of the bitmap by reconstructing the edge bits inside the image.
+ * Inputs:
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * Pool_T pool: the pool the marker is taken from, which keeps it until the
+ *              caller resets it
+ * Return: the number of sweeps that were needed, or 0 if the pool ran out
+ *         of memory for the marker, leaving the bitmap unchanged
+ * Expects
+ * - bitmap and pool to be non-null
+************************/
+int morphClearEdges(Bit2_T bitmap, Pool_T pool) {
+        assert(bitmap != NULL && pool != NULL);
+
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        int words = Bit2_row_words(bitmap);
+        int lastCol = width - 1;
+        Bit2_word *marker = Pool_calloc(pool, (long)height * words,
+                                        (long)sizeof(Bit2_word));
+        if (marker == NULL) {
+                return 0;
+        }
+
+        /* the marker starts as the black bits on the edges of the image */
+        for (int row = 0; row < height; row++) {
+                const Bit2_word *image = Bit2_row(bitmap, row);
+                Bit2_word *mark = marker + (long)row * words;
+
+                if (row == 0 || row == height - 1) {
+                        for (int w = 0; w < words; w++) {
+                                mark[w] = image[w];
+                        }
+                        continue;
+                }
+                mark[0] = image[0] & 1;
+                mark[lastCol / BIT2_WORD_BITS] |= 
+                        image[lastCol / BIT2_WORD_BITS] &
+                        (Bit2_word)1 << (lastCol % BIT2_WORD_BITS);
+                morphFillRow(mark, image, words);
+        }
+
+        /* sweeping in alternating directions until nothing changes */
+        int sweeps = 0;
+        bool down = true;
+        bool changed = true;
+        while (changed) {
+                changed = morphSweep(bitmap, marker, down);
+                down = !down;
+                sweeps++;
+        }
+
+        /* the marker is a subset of the image, so it can be xored away */
+        for (int row = 0; row < height; row++) {
+                Bit2_word *image = Bit2_row_mut(bitmap, row);
+                const Bit2_word *mark = marker + (long)row * words;
+                for (int w = 0; w < words; w++) {
+                        image[w] ^= mark[w];
+                }
+        }
+        return sweeps;
+}
+
+/**********morphSweep********
+ * About: This function visits every row once, in the given direction. Each
+ * row of the marker takes in the black bits of the image that are below a
+ * marked bit in the row above or below it, and is then filled along the
+ * black runs of its row.
+ * Inputs:
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * Bit2_word *marker: the marker, with the same row layout as the bitmap
+ * bool down: true to visit rows from top to bottom, false for bottom to top
+ * Return: true if any bit of the marker changed, false otherwise
+************************/
+bool morphSweep(Bit2_T bitmap, Bit2_word *marker, bool down) {
+        int height = Bit2_height(bitmap);
+        int words = Bit2_row_words(bitmap);
+        bool changed = false;
+
+        for (int i = 0; i < height; i++) {
+                int row = down ? i : height - 1 - i;
+                const Bit2_word *image = Bit2_row(bitmap, row);
+                Bit2_word *mark = marker + (long)row * words;
+                const Bit2_word *above = row > 0 ? mark - words : NULL;
+                const Bit2_word *below = row < height - 1 ? mark + words : 
+                                         NULL;
+
+                /* growing vertically from the neighbouring rows */
+                bool grew = false;
+                for (int w = 0; w < words; w++) {
+                        Bit2_word next = mark[w];
+                        if (above != NULL) {
+                                next |= above[w];
+                        }
+                        if (below != NULL) {
+                                next |= below[w];
+                        }
+                        next &= image[w];
+                        if (next != mark[w]) {
+                                mark[w] = next;
+                                grew = true;
+                        }
+                }
+
+                /* growing horizontally only when new bits were added */
+                if (grew) {
+                        morphFillRow(mark, image, words);
+                        changed = true;
+                }
+        }
+        return changed;
+}
+
+/**********morphFillRow********
+ * About: This function fills every black run of the image row that holds a
+ * marked bit. Adding the marked bits to the image row makes a carry ripple
+ * through the black run above each of them, so the run bits from a mark to
+ * the end of its run are the image bits that the add turned off. Running
+ * the same add on bit-reversed words fills the runs in the other direction,
+ * and carries are passed between words in both directions.
+ * Inputs:
+ * Bit2_word *marker: the marker row, a subset of the image row
+ * const Bit2_word *image: the image row
+ * int words: number of words in the row
+ * Return: none
+************************/
+void morphFillRow(Bit2_word *marker, const Bit2_word *image, int words) {
+        Bit2_word carry = 0;
+
+        /* filling towards higher columns */
+        for (int w = 0; w < words; w++) {
+                Bit2_word seeds = marker[w] | (carry & image[w]);
+                Bit2_word filled = (image[w] & ~(image[w] + seeds)) | seeds;
+                carry = filled >> (BIT2_WORD_BITS - 1);
+                marker[w] = filled;
+        }
+
+        /* filling towards lower columns on reversed words */
+        carry = 0;
+        for (int w = words - 1; w >= 0; w--) {
+                Bit2_word black = morphReverse(image[w]);
+                Bit2_word seeds = morphReverse(marker[w]) | (carry & black);
+                Bit2_word filled = (black & ~(black + seeds)) | seeds;
+                carry = filled >> (BIT2_WORD_BITS - 1);
+                marker[w] = morphReverse(filled);
+        }
+}
+
+/**********morphReverse********
+ * About: This function reverses the order of the bits of a word by swapping
+ * halves of growing size
+ * Inputs:
+ * Bit2_word word: the word to reverse
+ * Return: the reversed word
+************************/
+Bit2_word morphReverse(Bit2_word word) {
+        word = (word >> 1 & 0x5555555555555555) | 
+               (word & 0x5555555555555555) << 1;
+        word = (word >> 2 & 0x3333333333333333) | 
+               (word & 0x3333333333333333) << 2;
+        word = (word >> 4 & 0x0f0f0f0f0f0f0f0f) | 
+               (word & 0x0f0f0f0f0f0f0f0f) << 4;
+        word = (word >> 8 & 0x00ff00ff00ff00ff) | 
+               (word & 0x00ff00ff00ff00ff) << 8;
+        word = (word >> 16 & 0x0000ffff0000ffff) | 
+               (word & 0x0000ffff0000ffff) << 16;
+        return word >> 32 | word << 32;
+}
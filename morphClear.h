@@ -0,0 +1,21 @@
+/*
+ *     morphClear.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds an edge clearing engine based on morphological
+ *     reconstruction. The black bits on the edges of a Bit2_T bitmap are
+ *     grown inside the black bits of the bitmap 64 bits at a time, and
+ *     everything that was reached is made white.
+ *
+ */
+
+#ifndef MORPHCLEAR_INCLUDED
+#define MORPHCLEAR_INCLUDED
+
+#include <bit2.h>
+#include <pool.h>
+
+extern int morphClearEdges(Bit2_T bitmap, Pool_T pool);
+
+#endif
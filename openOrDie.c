@@ -5,14 +5,22 @@
  *
  *     About: This file holds the openOrDie function that checks if the
  *     program is started with the correct number of arguments (1 or 2) and
- *     tries to opening a file from the given arguments or from stdin.
+ *     tries to opening a file from the given arguments or from stdin. A
+ *     regular file can also be memory-mapped so that it is read in place.
  *     
  */
 
+/* mmap, fstat and open are POSIX, not part of c99 */
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <openOrDie.h>
 #include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /**********openOrDie********
  *
@@ -44,4 +52,70 @@ FILE *openOrDie(int argc, char *argv[]) {
         /* checking if the file is opened correctly (runtime error) */
         assert(fp != NULL);
         return fp;
-}
\ No newline at end of file
+}
+
+/**********mapOrOpenOrDie********
+ *
+ * About: checks if the program is started with the correct number of
+ *        arguments. If a regular, non-empty file is given, it is mapped into
+ *        memory. Otherwise (stdin, pipes and devices, or a file that cannot
+ *        be mapped) the input is opened as a stream like openOrDie does.
+ * Inputs:
+ *      int argc: number of given arguments to start the program
+ *      char *argv: an array that stores the arguments
+ * Return: a MappedFile holding either the mapped bytes or the stream
+ * Expects:
+ *      If the given arguments do not equal 1 or 2, throws CRE 
+ *      If the file cannot be opened, throws CRE 
+ *
+ ************************/
+MappedFile mapOrOpenOrDie(int argc, char *argv[]) {
+        assert(argc == 1 || argc == 2);
+
+        MappedFile file = { NULL, 0, NULL };
+        if (argc == 2) {
+                int fd = open(argv[1], O_RDONLY);
+                assert(fd != -1);
+
+                struct stat info;
+                if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) &&
+                    info.st_size > 0) {
+                        void *data = mmap(NULL, info.st_size, PROT_READ, 
+                                          MAP_PRIVATE, fd, 0);
+                        if (data != MAP_FAILED) {
+                                file.data = data;
+                                file.length = info.st_size;
+                        }
+                }
+                close(fd);
+                if (file.data != NULL) {
+                        return file;
+                }
+        }
+
+        /* falling back to reading a stream */
+        file.fp = openOrDie(argc, argv);
+        return file;
+}
+
+/**********closeMapped********
+ *
+ * About: unmaps or closes an input opened by mapOrOpenOrDie
+ * Inputs:
+ *      MappedFile *file: the input to close
+ * Expects:
+ *      file to be non-null
+ *
+ ************************/
+void closeMapped(MappedFile *file) {
+        assert(file != NULL);
+
+        if (file->data != NULL) {
+                munmap((void *)file->data, file->length);
+                file->data = NULL;
+        }
+        else {
+                fclose(file->fp);
+                file->fp = NULL;
+        }
+}
@@ -5,7 +5,9 @@
  *
  *     About: This file holds the openOrDie function that checks if the
  *     program is started with the correct number of arguments (1 or 2) and
- *     tries to opening a stream from the given arguments or from stdin.
+ *     tries to opening a stream from the given arguments or from stdin. It
+ *     also holds mapOrOpenOrDie, which memory-maps the file instead when it
+ *     is a regular file.
  *     
  */
 
@@ -15,7 +17,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+/**********struct MappedFile********
+ * About: This struct holds an input that is either memory-mapped or, for
+ *        stdin and pipes, opened as a stream.
+************************/
+typedef struct MappedFile {
+        const unsigned char *data; /* the mapped bytes, or NULL if fp is used */
+        size_t length; /* number of mapped bytes */
+        FILE *fp; /* the opened stream, or NULL if the file is mapped */
+} MappedFile;
+
 extern FILE *openOrDie(int argc, char *argv[]);
+extern MappedFile mapOrOpenOrDie(int argc, char *argv[]);
+extern void closeMapped(MappedFile *file);
 
 
-#endif
\ No newline at end of file
+#endif
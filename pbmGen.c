@@ -0,0 +1,255 @@
+/*
+ *     pbmGen.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file generates synthetic bitmaps for benchmarking the edge
+ *     clearing engines:
+ *     - frame: a thick black frame around the page with black specks of the
+ *       given density inside it, so nearly every black bit touches an edge
+ *     - spiral: a maze of one bit wide walls and corridors winding from the
+ *       corner of the page to its middle, which is one very long path of
+ *       black bits for the flood fills to follow
+ *     - noise: every bit is black with the given density; densities around
+ *       0.59 make huge winding components
+ *     Very wide or very tall pages are made by picking the width and height.
+ *     The random bits come from a xorshift generator seeded by the caller,
+ *     so the bitmaps do not depend on the C library.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <bit2.h>
+#include <pbmGen.h>
+
+/* function declarations */
+uint64_t pbmGenRandom(uint64_t *state);
+void pbmGenNoise(Bit2_T bitmap, int firstCol, int firstRow, int lastCol,
+                 int lastRow, double density, uint64_t *state);
+void pbmGenFrame(Bit2_T bitmap, double density, uint64_t *state);
+void pbmGenSpiral(Bit2_T bitmap);
+bool pbmGenCanStep(Bit2_T bitmap, int col, int row, int dCol, int dRow);
+
+/* the name of each kind, in the order of the PbmGenKind enum */
+static const char *pbmGenNames[] = { "frame", "spiral", "noise" };
+
+#define PBMGEN_KINDS 3
+
+/**********pbmGenParse********
+ * About: This function finds the kind of bitmap with the given name
+ * Inputs:
+ * const char *name: the name of the kind
+ * PbmGenKind *kind: pointer to where the kind is stored
+ * Return: true if there is a kind with the name, false otherwise
+ * Expects
+ * - name and kind to be non-null
+************************/
+bool pbmGenParse(const char *name, PbmGenKind *kind) {
+        assert(name != NULL && kind != NULL);
+
+        for (int i = 0; i < PBMGEN_KINDS; i++) {
+                if (strcmp(name, pbmGenNames[i]) == 0) {
+                        *kind = (PbmGenKind)i;
+                        return true;
+                }
+        }
+        return false;
+}
+
+/**********pbmGenName********
+ * About: This function returns the name of a kind of bitmap
+ * Inputs:
+ * PbmGenKind kind: the kind
+ * Return: the name of the kind
+************************/
+const char *pbmGenName(PbmGenKind kind) {
+        assert((int)kind >= 0 && (int)kind < PBMGEN_KINDS);
+        return pbmGenNames[kind];
+}
+
+/**********pbmGenerate********
+ * About: This function makes a new bitmap of the given kind
+ * Inputs:
+ * PbmGenKind kind: the kind of bitmap to make
+ * int width: the number of cols of the bitmap
+ * int height: the number of rows of the bitmap
+ * double density: the chance of a bit being black, for noise and for the
+ *                 inside of a frame (ignored by spiral)
+ * uint64_t seed: the seed of the random bits
+ * Return: the new bitmap, which the caller frees with Bit2_free
+ * Expects
+ * - width and height to be positive and density to be in [0, 1]
+************************/
+Bit2_T pbmGenerate(PbmGenKind kind, int width, int height, double density,
+                   uint64_t seed) {
+        assert(width > 0 && height > 0);
+        assert(density >= 0 && density <= 1);
+
+        Bit2_T bitmap = Bit2_new(width, height);
+        /* a zero state would only ever give zeros */
+        uint64_t state = seed ^ 0x9E3779B97F4A7C15ULL;
+        if (state == 0) {
+                state = 1;
+        }
+
+        if (kind == PBMGEN_FRAME) {
+                pbmGenFrame(bitmap, density, &state);
+        }
+        else if (kind == PBMGEN_SPIRAL) {
+                pbmGenSpiral(bitmap);
+        }
+        else {
+                pbmGenNoise(bitmap, 0, 0, width - 1, height - 1, density,
+                            &state);
+        }
+        return bitmap;
+}
+
+/**********pbmGenRandom********
+ * About: This function steps a xorshift64* generator
+ * Inputs:
+ * uint64_t *state: the non-zero state of the generator
+ * Return: the next 64 random bits
+************************/
+uint64_t pbmGenRandom(uint64_t *state) {
+        uint64_t x = *state;
+        x ^= x >> 12;
+        x ^= x << 25;
+        x ^= x >> 27;
+        *state = x;
+        return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**********pbmGenNoise********
+ * About: This function makes every bit in a rectangle black with the given
+ * density. The rectangle is walked in row major order so the bitmap only
+ * depends on the seed.
+ * Inputs:
+ * Bit2_T bitmap: the bitmap being generated
+ * int firstCol, int firstRow: the top left corner of the rectangle
+ * int lastCol, int lastRow: the bottom right corner of the rectangle
+ * double density: the chance of a bit being black
+ * uint64_t *state: the state of the random generator
+ * Return: none
+************************/
+void pbmGenNoise(Bit2_T bitmap, int firstCol, int firstRow, int lastCol,
+                 int lastRow, double density, uint64_t *state) {
+        /* comparing the top 53 bits keeps the chance exact for a double */
+        uint64_t limit = (uint64_t)(density * (double)(1ULL << 53));
+
+        for (int row = firstRow; row <= lastRow; row++) {
+                Bit2_word *span = Bit2_row_mut(bitmap, row);
+                for (int col = firstCol; col <= lastCol; col++) {
+                        if ((pbmGenRandom(state) >> 11) < limit) {
+                                span[col / BIT2_WORD_BITS] |= (Bit2_word)1 <<
+                                        (col % BIT2_WORD_BITS);
+                        }
+                }
+        }
+}
+
+/**********pbmGenFrame********
+ * About: This function draws a black frame an eighth of the shorter side
+ * thick (at least one bit) around the bitmap and fills the inside with
+ * noise of the given density.
+ * Inputs:
+ * Bit2_T bitmap: the bitmap being generated
+ * double density: the chance of a bit inside the frame being black
+ * uint64_t *state: the state of the random generator
+ * Return: none
+************************/
+void pbmGenFrame(Bit2_T bitmap, double density, uint64_t *state) {
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        int thick = (width < height ? width : height) / 8;
+        if (thick < 1) {
+                thick = 1;
+        }
+
+        for (int row = 0; row < height; row++) {
+                bool wholeRow = row < thick || row >= height - thick;
+                for (int col = 0; col < width; col++) {
+                        if (wholeRow || col < thick || col >= width - thick) {
+                                Bit2_put(bitmap, col, row, 1);
+                        }
+                }
+        }
+        if (width > 2 * thick && height > 2 * thick) {
+                pbmGenNoise(bitmap, thick, thick, width - thick - 1,
+                            height - thick - 1, density, state);
+        }
+}
+
+/**********pbmGenSpiral********
+ * About: This function draws a spiral wall starting at the top left corner.
+ * A turtle walks right, down, left and up, turning clockwise whenever a
+ * step would close the one bit wide corridor next to an older wall, and
+ * stops when it cannot move in any direction.
+ * Inputs:
+ * Bit2_T bitmap: the bitmap being generated
+ * Return: none
+************************/
+void pbmGenSpiral(Bit2_T bitmap) {
+        static const int dCols[4] = { 1, 0, -1, 0 };
+        static const int dRows[4] = { 0, 1, 0, -1 };
+        int col = 0, row = 0, dir = 0;
+        int turns = 0;
+
+        Bit2_put(bitmap, col, row, 1);
+        while (turns < 2) {
+                if (pbmGenCanStep(bitmap, col, row, dCols[dir], dRows[dir])) {
+                        col += dCols[dir];
+                        row += dRows[dir];
+                        Bit2_put(bitmap, col, row, 1);
+                        turns = 0;
+                }
+                else {
+                        dir = (dir + 1) % 4;
+                        turns++;
+                }
+        }
+}
+
+/**********pbmGenCanStep********
+ * About: This function tells if the spiral turtle may step in a direction.
+ * The step must stay on the bitmap, land on a white bit and leave a white
+ * bit (or the edge) past it, and it may not touch older walls on its sides.
+ * Inputs:
+ * Bit2_T bitmap: the bitmap being generated
+ * int col, int row: where the turtle is
+ * int dCol, int dRow: the direction of the step
+ * Return: true if the turtle may step, false otherwise
+************************/
+bool pbmGenCanStep(Bit2_T bitmap, int col, int row, int dCol, int dRow) {
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        int nextCol = col + dCol, nextRow = row + dRow;
+
+        if (nextCol < 0 || nextCol >= width || nextRow < 0 ||
+            nextRow >= height || Bit2_get(bitmap, nextCol, nextRow) == 1) {
+                return false;
+        }
+        /* the bit past the step must be white or off the bitmap */
+        int pastCol = nextCol + dCol, pastRow = nextRow + dRow;
+        if (pastCol >= 0 && pastCol < width && pastRow >= 0 &&
+            pastRow < height && Bit2_get(bitmap, pastCol, pastRow) == 1) {
+                return false;
+        }
+        /* the bits beside the step must be white so corridors stay open */
+        for (int side = -1; side <= 1; side += 2) {
+                int sideCol = nextCol + side * dRow;
+                int sideRow = nextRow + side * dCol;
+                if (sideCol >= 0 && sideCol < width && sideRow >= 0 &&
+                    sideRow < height &&
+                    Bit2_get(bitmap, sideCol, sideRow) == 1) {
+                        return false;
+                }
+        }
+        return true;
+}
+
+#undef PBMGEN_KINDS
@@ -0,0 +1,29 @@
+/*
+ *     pbmGen.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to make synthetic Bit2_T bitmaps that are
+ *     hard on the edge clearing engines. The same kind, size, density and
+ *     seed always give the same bitmap, so benchmark numbers can be repeated.
+ *
+ */
+
+#ifndef PBMGEN_INCLUDED
+#define PBMGEN_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <bit2.h>
+
+/* the kinds of bitmaps that can be generated */
+typedef enum {
+        PBMGEN_FRAME, PBMGEN_SPIRAL, PBMGEN_NOISE
+} PbmGenKind;
+
+extern bool pbmGenParse(const char *name, PbmGenKind *kind);
+extern const char *pbmGenName(PbmGenKind kind);
+extern Bit2_T pbmGenerate(PbmGenKind kind, int width, int height,
+                          double density, uint64_t seed);
+
+#endif
@@ -12,126 +12,983 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <pbmReadWrite.h>
 #include <assert.h>
 #include <bit2.h>
-#include <pnmrdr.h>
 #include <except.h>
 #include <mem.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* function declarations */
+int pbmGetc(PbmInput *input);
+void pbmUngetc(PbmInput *input, int c);
+int pbmSkipSpace(PbmInput *input);
+bool pbmReadNumber(PbmInput *input, int *value);
+bool pbmInputHeader(PbmInput *input, PbmHeader *header);
+bool pbmReadPlainRow(PbmInput *input, int width, Bit2_word *span);
+int pbmScanPlainRow(PbmInput *input, int width, Bit2_word *span);
+size_t pbmRenderPlainRow(char *text, int width, const Bit2_word *span);
+size_t pbmRenderRawRow(unsigned char *bytes, int width,
+                       const Bit2_word *span);
+int pbmRenderHeader(char *text, int format, int width, int height);
+bool pbmRefill(PbmInput *input);
+void pbmPackRawRow(const unsigned char *bytes, int width, Bit2_word *span);
+
+/* reverses the bit order of a byte: raw pbm rows store the leftmost pixel in
+ * the most significant bit, while a Bit2_T stores it in the least one */
+#define R2(n) (n), (n) + 2 * 64, (n) + 1 * 64, (n) + 3 * 64
+#define R4(n) R2(n), R2((n) + 2 * 16), R2((n) + 1 * 16), R2((n) + 3 * 16)
+#define R6(n) R4(n), R4((n) + 2 * 4), R4((n) + 1 * 4), R4((n) + 3 * 4)
+static const unsigned char reversedByte[256] = {
+        R6(0), R6(2), R6(1), R6(3)
+};
+#undef R2
+#undef R4
+#undef R6
+
+/* the plain pbm text of the 8 bits of a byte, lowest bit (leftmost pixel)
+ * first, so a row is written 8 pixels at a time with one copy */
+#define B(n, i) (char)('0' + (((n) >> (i)) & 1))
+#define T1(n) { B(n, 0), B(n, 1), B(n, 2), B(n, 3), \
+                B(n, 4), B(n, 5), B(n, 6), B(n, 7) }
+#define T4(n) T1(n), T1((n) + 1), T1((n) + 2), T1((n) + 3)
+#define T16(n) T4(n), T4((n) + 4), T4((n) + 8), T4((n) + 12)
+#define T64(n) T16(n), T16((n) + 16), T16((n) + 32), T16((n) + 48)
+static const char byteText[256][8] = {
+        T64(0), T64(64), T64(128), T64(192)
+};
+#undef B
+#undef T1
+#undef T4
+#undef T16
+#undef T64
+
+/* size of the text buffer of pbmWrite, which holds many rows */
+#define PBM_TEXT_BUFFER (1 << 16)
+
+/* room for the longest header, "P4\n" and two ints with their spaces */
+#define PBM_HEADER_TEXT 32
+
+/* size of the chunks the bits of a plain file are read in */
+#define PBM_READ_CHUNK (1 << 16)
 
 /**********pbmRead********
  *
  * About: This function takes a pbm file and stores the data into a newly
- *        created Bit2_T bitVector
+ *        created Bit2_T bitVector stored in rows, with pbmReadLayout
  * Inputs: 
- * FILE *inputfp: a pointer to a file to get the data using Pnmrdr_new
+ * FILE *inputfp: a pointer to a file to read the pbm data from
  * Return: Bit2_T bitVector where the opened data from the file is stored
  * Expects: 
  * - the given file input is in the pbm format
  * - the given file input is a bitmap and has the correct dimensions
  ************************/
 Bit2_T pbmRead(FILE *inputfp) {
-        /* checking if the input is in the pbm format */
-        Except_T Pnmrdr_Badformat;
-        Pnmrdr_T image;
-        
-        TRY 
-                image = Pnmrdr_new(inputfp);
-        EXCEPT(Pnmrdr_Badformat) {
-                fclose(inputfp);
-                fprintf(stderr, "pbm file promised but not delivered\n");
-                exit(EXIT_FAILURE);
-        }       
-        END_TRY;
+        return pbmReadLayout(inputfp, BIT2_ROWS);
+}
 
+/**********pbmReadLayout********
+ *
+ * About: This function takes a pbm file and stores the data into a newly
+ *        created Bit2_T bitVector in the given layout. The header is parsed
+ *        here; raw (P4) rows are copied into the bitVector a byte at a
+ *        time. The rest of a plain (P1) file is read PBM_READ_CHUNK bytes at
+ *        a time so that its bits can be scanned in blocks, a row at a time
+ *        with arrayFiller, without holding the whole text in memory. The
+ *        rows of a blocked bitVector are scattered into its blocks as they
+ *        are read, so it never needs a copy stored in rows.
+ * Inputs: 
+ * FILE *inputfp: a pointer to a file to read the pbm data from
+ * Bit2_Layout layout: BIT2_ROWS or BIT2_BLOCKED
+ * Return: Bit2_T bitVector where the opened data from the file is stored
+ * Expects: 
+ * - the given file input is in the pbm format
+ * - the given file input is a bitmap and has the correct dimensions
+ ************************/
+Bit2_T pbmReadLayout(FILE *inputfp, Bit2_Layout layout) {
         /* checking if the input is a bitmap and has the correct dimensions */
-        Pnmrdr_mapdata imageMap = Pnmrdr_data(image);
-        if (imageMap.type != 1 || imageMap.width == 0 || 
-            imageMap.height == 0) {
-                Pnmrdr_free(&image);
-                fclose(inputfp);
-                fprintf(stderr, "pbm file promised but not delivered\n");
-                exit(EXIT_FAILURE);
+        PbmHeader header;
+        if (!pbmReadHeader(inputfp, &header)) {
+                pbmBadFormat(inputfp, NULL);
         }
-        Bit2_T bitVector = Bit2_new(imageMap.width, imageMap.height);
+        Bit2_T bitVector = Bit2_new_layout(header.width, header.height,
+                                           layout);
         
-        /* reading input from the file and fillind the bitVector */
-        Bit2_map_row_major(bitVector, arrayFiller, image);
-        Pnmrdr_free(&image);
+        /* reading input from the file and filling the bitVector */
+        if (header.format == PBM_RAW) {
+                if (!pbmReadRaw(inputfp, bitVector)) {
+                        pbmBadFormat(inputfp, &bitVector);
+                }
+        }
+        else {
+                unsigned char *chunk = ALLOC(PBM_READ_CHUNK);
+                PbmInput input = { inputfp, chunk, 0, 0, chunk,
+                                   PBM_READ_CHUNK };
+                Bit2_map_rows(bitVector, arrayFiller, &input);
+                FREE(chunk);
+        }
+        return bitVector;
+}
+
+/**********pbmRefill********
+ *
+ * About: This function refills the chunk of a file read a chunk at a time.
+ *        The bytes not read yet, such as the start of a row that straddles
+ *        two chunks, are carried over to the front of the chunk and the
+ *        rest of it is filled from the file.
+ * Inputs: 
+ * PbmInput *input: the input
+ * Return: true if more bytes were read, false if the input is a buffer or
+ *         a plain file, or the file has ended
+ ************************/
+bool pbmRefill(PbmInput *input) {
+        if (input->chunk == NULL || input->fp == NULL) {
+                return false;
+        }
+
+        size_t left = input->length - input->pos;
+        memmove(input->chunk, input->chunk + input->pos, left);
+        size_t got = fread(input->chunk + left, 1, input->capacity - left,
+                           input->fp);
+        input->data = input->chunk;
+        input->length = left + got;
+        input->pos = 0;
+        return got > 0;
+}
+
+/**********pbmReadMapped********
+ *
+ * About: This function stores the pbm file held in a buffer (such as a
+ *        memory-mapped file) into a newly created Bit2_T bitVector stored
+ *        in rows, with pbmReadMappedLayout
+ * Inputs: 
+ * const unsigned char *data: the bytes of the pbm file
+ * size_t length: the number of bytes in data
+ * Return: Bit2_T bitVector where the data from the buffer is stored
+ * Expects: 
+ * - data to be non-null
+ * - the given buffer holds a pbm file with the correct dimensions
+ ************************/
+Bit2_T pbmReadMapped(const unsigned char *data, size_t length) {
+        return pbmReadMappedLayout(data, length, BIT2_ROWS);
+}
+
+/**********pbmReadMappedLayout********
+ *
+ * About: This function stores the pbm file held in a buffer (such as a
+ *        memory-mapped file) into a newly created Bit2_T bitVector in the
+ *        given layout with pbmReadBuffer, exiting if the buffer is not a
+ *        valid pbm file and raising Mem_Failed if there is no memory for
+ *        the image.
+ * Inputs: 
+ * const unsigned char *data: the bytes of the pbm file
+ * size_t length: the number of bytes in data
+ * Bit2_Layout layout: BIT2_ROWS or BIT2_BLOCKED
+ * Return: Bit2_T bitVector where the data from the buffer is stored
+ * Expects: 
+ * - data to be non-null
+ * - the given buffer holds a pbm file with the correct dimensions
+ ************************/
+Bit2_T pbmReadMappedLayout(const unsigned char *data, size_t length,
+                           Bit2_Layout layout) {
+        assert(data != NULL);
+
+        Bit2_T bitVector = Bit2_new_layout(1, 1, layout);
+        PbmReadStatus status = pbmReadBuffer(data, length, bitVector);
+        if (status == PBM_READ_NO_MEMORY) {
+                Bit2_free(&bitVector);
+                RAISE(Mem_Failed);
+        }
+        if (status == PBM_READ_BAD) {
+                pbmBadFormat(NULL, &bitVector);
+        }
         return bitVector;
 }
 
+/**********pbmReadBuffer********
+ *
+ * About: This function stores the pbm file held in a buffer into an
+ *        existing Bit2_T, which is reshaped to the size of the image so
+ *        that its words can be reused from one image to the next. Raw (P4)
+ *        rows are packed into the bitmap straight from the buffer without
+ *        being copied first, and plain (P1) rows are read one at a time.
+ *        A blocked bitmap has each row read into a span first and then
+ *        scattered into its blocks with Bit2_put_row.
+ *        Unlike pbmRead it does not exit on a bad file, and the bitmap is
+ *        only reshaped once the buffer is known to be long enough for the
+ *        size in the header, so a short buffer claiming a huge image does
+ *        not make it allocate.
+ * Inputs: 
+ * const unsigned char *data: the bytes of the pbm file
+ * size_t length: the number of bytes in data
+ * Bit2_T bitmap: the bitmap the image is stored in, in either layout
+ * Return: PBM_READ_OK if the buffer held a valid pbm file, PBM_READ_BAD if
+ *         it did not, in which case the contents of bitmap are unspecified,
+ *         and PBM_READ_NO_MEMORY if the bitmap could not be reshaped to the
+ *         size of the image (or the span of a blocked bitmap allocated), in
+ *         which case it is left as it was
+ * Expects: 
+ * - data and bitmap to be non-null
+ ************************/
+PbmReadStatus pbmReadBuffer(const unsigned char *data, size_t length,
+                            Bit2_T bitmap) {
+        assert(data != NULL && bitmap != NULL);
+
+        PbmInput input = { NULL, data, length, 0, NULL, 0 };
+        PbmHeader header;
+        if (!pbmInputHeader(&input, &header)) {
+                return PBM_READ_BAD;
+        }
+
+        /* a raw row takes (width + 7) / 8 bytes and a plain bit at least 1 */
+        size_t rowBytes = header.format == PBM_RAW ?
+                          ((size_t)header.width + 7) / 8 :
+                          (size_t)header.width;
+        if ((length - input.pos) / rowBytes < (size_t)header.height) {
+                return PBM_READ_BAD;
+        }
+        Bit2_word *scratch = NULL;
+        if (Bit2_layout(bitmap) == BIT2_BLOCKED) {
+                scratch = malloc(((size_t)header.width + BIT2_WORD_BITS - 1) /
+                                 BIT2_WORD_BITS * sizeof(Bit2_word));
+                if (scratch == NULL) {
+                        return PBM_READ_NO_MEMORY;
+                }
+        }
+        if (!Bit2_reshape(bitmap, header.width, header.height)) {
+                free(scratch);
+                return PBM_READ_NO_MEMORY;
+        }
+
+        PbmReadStatus status = PBM_READ_OK;
+        for (int row = 0; row < header.height && status == PBM_READ_OK;
+             row++) {
+                Bit2_word *span = scratch != NULL ? scratch :
+                                  Bit2_row_mut(bitmap, row);
+                if (header.format == PBM_RAW) {
+                        pbmPackRawRow(data + input.pos + row * rowBytes,
+                                      header.width, span);
+                }
+                else if (!pbmReadPlainRow(&input, header.width, span)) {
+                        status = PBM_READ_BAD;
+                }
+                if (scratch != NULL) {
+                        Bit2_put_row(bitmap, row, span);
+                }
+        }
+        free(scratch);
+        return status;
+}
+
+/**********pbmReadHeader********
+ *
+ * About: This function reads the header of a plain or raw pbm file, leaving
+ *        the file positioned at the first bit of the image
+ * Inputs: 
+ * FILE *inputfp: a pointer to a file to read the header from
+ * PbmHeader *header: pointer to the struct filled with the header info
+ * Return: true if a valid pbm header with nonzero dimensions was read, false
+ *         otherwise
+ * Expects: 
+ * - inputfp and header to be non-null
+ ************************/
+bool pbmReadHeader(FILE *inputfp, PbmHeader *header) {
+        assert(inputfp != NULL && header != NULL);
+
+        PbmInput input = { inputfp, NULL, 0, 0, NULL, 0 };
+        return pbmInputHeader(&input, header);
+}
+
+/**********pbmInputHeader********
+ *
+ * About: This function reads the header of a plain or raw pbm file from a
+ *        file or a buffer, leaving it positioned at the first bit of the
+ *        image
+ * Inputs: 
+ * PbmInput *input: where the header is read from
+ * PbmHeader *header: pointer to the struct filled with the header info
+ * Return: true if a valid pbm header with nonzero dimensions was read, false
+ *         otherwise
+ ************************/
+bool pbmInputHeader(PbmInput *input, PbmHeader *header) {
+        /* checking the magic number */
+        if (pbmGetc(input) != 'P') {
+                return false;
+        }
+        int magic = pbmGetc(input);
+        if (magic != '0' + PBM_PLAIN && magic != '0' + PBM_RAW) {
+                return false;
+        }
+        header->format = magic - '0';
+
+        if (!pbmReadNumber(input, &header->width) ||
+            !pbmReadNumber(input, &header->height) ||
+            header->width == 0 || header->height == 0) {
+                return false;
+        }
+
+        /* a raw raster starts right after a single whitespace character */
+        if (header->format == PBM_RAW) {
+                int c = pbmGetc(input);
+                if (c != ' ' && c != '\t' && c != '\n' && c != '\r' &&
+                    c != '\v' && c != '\f') {
+                        return false;
+                }
+        }
+        return true;
+}
+
+/**********pbmReadRaw********
+ *
+ * About: This function reads the packed rows of a raw (P4) pbm file into the
+ *        given bitmap, one row at a time with pbmReadRow. The rows of a
+ *        blocked bitmap are read into a span and scattered into its blocks.
+ * Inputs: 
+ * FILE *inputfp: a pointer to a file positioned at the start of the raster
+ * Bit2_T bitmap: a bitmap with the dimensions given in the header
+ * Return: true if all rows were read, false if the file ended early
+ * Expects: 
+ * - inputfp and bitmap to be non-null
+ ************************/
+bool pbmReadRaw(FILE *inputfp, Bit2_T bitmap) {
+        assert(inputfp != NULL && bitmap != NULL);
+
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        unsigned char *bytes = ALLOC((width + 7) / 8);
+        bool blocked = Bit2_layout(bitmap) == BIT2_BLOCKED;
+        Bit2_word *scratch = blocked ? CALLOC((width + BIT2_WORD_BITS - 1) /
+                                              BIT2_WORD_BITS,
+                                              sizeof(Bit2_word)) : NULL;
+        bool complete = true;
+
+        for (int row = 0; row < height && complete; row++) {
+                Bit2_word *span = blocked ? scratch :
+                                  Bit2_row_mut(bitmap, row);
+                complete = pbmReadRow(inputfp, PBM_RAW, width, span, bytes);
+                if (blocked) {
+                        Bit2_put_row(bitmap, row, span);
+                }
+        }
+        FREE(bytes);
+        if (blocked) {
+                FREE(scratch);
+        }
+        return complete;
+}
+
+/**********pbmReadRow********
+ *
+ * About: This function reads the next row of a pbm file into a row span.
+ *        A raw row is read with one fread, and its bytes are bit-reversed
+ *        and stored 8 at a time into the words of the span. A plain row is
+ *        read one digit at a time.
+ * Inputs: 
+ * FILE *inputfp: a pointer to a file positioned at the start of a row
+ * int format: PBM_PLAIN or PBM_RAW
+ * int width: the number of bits in a row
+ * Bit2_word *span: the (width + 63) / 64 words the row is stored in, with
+ *                  the padding bits set to 0
+ * unsigned char *bytes: a buffer of (width + 7) / 8 bytes for raw rows, may
+ *                       be NULL for plain rows
+ * Return: true if the row was read, false if the file ended early or holds
+ *         something other than a bit
+ * Expects: 
+ * - inputfp and span to be non-null
+ ************************/
+bool pbmReadRow(FILE *inputfp, int format, int width, Bit2_word *span,
+                unsigned char *bytes) {
+        assert(inputfp != NULL && span != NULL);
+
+        if (format == PBM_PLAIN) {
+                PbmInput input = { inputfp, NULL, 0, 0, NULL, 0 };
+                return pbmReadPlainRow(&input, width, span);
+        }
+
+        assert(bytes != NULL);
+        size_t rowBytes = (width + 7) / 8;
+        if (fread(bytes, 1, rowBytes, inputfp) != rowBytes) {
+                return false;
+        }
+        pbmPackRawRow(bytes, width, span);
+        return true;
+}
+
+/**********pbmReadPlainRow********
+ *
+ * About: This function reads the next row of a plain (P1) pbm file into a
+ *        row span. A row held in a buffer is scanned 16 bytes at a time by
+ *        pbmScanPlainRow where SSE2 is available; the bits it leaves, and
+ *        every bit of a row read from a file, are read one digit at a time.
+ * Inputs: 
+ * PbmInput *input: where the row is read from
+ * int width: the number of bits in a row
+ * Bit2_word *span: the (width + 63) / 64 words the row is stored in
+ * Return: true if the row was read, false if the input ended early or holds
+ *         something other than a bit
+ ************************/
+bool pbmReadPlainRow(PbmInput *input, int width, Bit2_word *span) {
+        int words = (width + BIT2_WORD_BITS - 1) / BIT2_WORD_BITS;
+
+        for (int w = 0; w < words; w++) {
+                span[w] = 0;
+        }
+        int col = 0;
+        if (input->data != NULL) {
+                col = pbmScanPlainRow(input, width, span);
+        }
+        for (; col < width; col++) {
+                int c = pbmSkipSpace(input);
+                if (c != '0' && c != '1') {
+                        return false;
+                }
+                span[col / BIT2_WORD_BITS] |= (Bit2_word)(c - '0') <<
+                                              (col % BIT2_WORD_BITS);
+        }
+        return true;
+}
+
+/**********pbmScanPlainRow********
+ *
+ * About: This function reads as much of a plain (P1) row held in a buffer as
+ *        it can, 16 bytes at a time. Each block is compared with '0', '1'
+ *        and the whitespace characters using SSE2, giving one mask of the
+ *        digits and one of the '1's. A block of only digits adds its 16
+ *        bits at once, a block of digits each followed by one space (the
+ *        usual "0 1 0 1" layout) adds its 8 bits after squeezing out every
+ *        other bit, and any other mix adds its digits one mask bit at a
+ *        time. A block holding anything else, such as a comment, has its
+ *        next digit read with pbmSkipSpace before the scan goes on. Without
+ *        SSE2 nothing is read here. A chunk of a file holding fewer than 16
+ *        bytes is refilled first.
+ * Inputs: 
+ * PbmInput *input: the buffer, positioned in the row
+ * int width: the number of bits in a row
+ * Bit2_word *span: the zeroed words the row is stored in
+ * Return: the number of bits of the row that were read, the rest being
+ *         left to the caller
+ ************************/
+int pbmScanPlainRow(PbmInput *input, int width, Bit2_word *span) {
+        int col = 0;
+#ifdef __SSE2__
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i one = _mm_set1_epi8('1');
+        const __m128i space = _mm_set1_epi8(' ');
+        /* tab, newline, vertical tab, form feed and return are 9 to 13 */
+        const __m128i below = _mm_set1_epi8('\t' - 1);
+        const __m128i above = _mm_set1_epi8('\r' + 1);
+
+        while (col < width && (input->length - input->pos >= 16 ||
+                               (pbmRefill(input) &&
+                                input->length - input->pos >= 16))) {
+                __m128i block = _mm_loadu_si128((const __m128i *)
+                                                (input->data + input->pos));
+                __m128i ones = _mm_cmpeq_epi8(block, one);
+                __m128i digits = _mm_or_si128(ones,
+                                              _mm_cmpeq_epi8(block, zero));
+                __m128i spaces = _mm_or_si128(
+                        _mm_cmpeq_epi8(block, space),
+                        _mm_and_si128(_mm_cmpgt_epi8(block, below),
+                                      _mm_cmplt_epi8(block, above)));
+                unsigned digitMask = _mm_movemask_epi8(digits);
+                unsigned oneMask = _mm_movemask_epi8(ones);
+                unsigned known = digitMask | _mm_movemask_epi8(spaces);
+                int count = __builtin_popcount(digitMask);
+
+                /* comments, bad bytes and the end of the row, one at a time */
+                if (known != 0xffff || count > width - col) {
+                        int c = pbmSkipSpace(input);
+                        if (c != '0' && c != '1') {
+                                pbmUngetc(input, c);
+                                break;
+                        }
+                        span[col / BIT2_WORD_BITS] |= (Bit2_word)(c - '0') <<
+                                                      (col % BIT2_WORD_BITS);
+                        col++;
+                        continue;
+                }
+
+                Bit2_word bits;
+                if (digitMask == 0xffff) {
+                        bits = oneMask;
+                }
+                else if (digitMask == 0x5555) {
+                        /* keeping the even bits, packed together */
+                        bits = oneMask & 0x5555;
+                        bits = (bits | bits >> 1) & 0x3333;
+                        bits = (bits | bits >> 2) & 0x0f0f;
+                        bits = (bits | bits >> 4) & 0x00ff;
+                }
+                else {
+                        bits = 0;
+                        for (int i = 0; digitMask != 0; i++) {
+                                int b = __builtin_ctz(digitMask);
+                                bits |= (Bit2_word)((oneMask >> b) & 1) << i;
+                                digitMask &= digitMask - 1;
+                        }
+                }
+                input->pos += 16;
+
+                int shift = col % BIT2_WORD_BITS;
+                span[col / BIT2_WORD_BITS] |= bits << shift;
+                if (shift + count > BIT2_WORD_BITS) {
+                        span[col / BIT2_WORD_BITS + 1] |=
+                                bits >> (BIT2_WORD_BITS - shift);
+                }
+                col += count;
+        }
+#else
+        (void)input;
+        (void)width;
+        (void)span;
+#endif
+        return col;
+}
+
+/**********pbmPackRawRow********
+ *
+ * About: This function packs a row of a raw (P4) pbm file into a row span.
+ *        The bytes are bit-reversed and stored 8 at a time into the words
+ *        of the span.
+ * Inputs: 
+ * const unsigned char *bytes: the (width + 7) / 8 bytes of the raw row
+ * int width: the number of bits in a row
+ * Bit2_word *span: the (width + 63) / 64 words the row is stored in, with
+ *                  the padding bits set to 0
+ * Return: none
+ ************************/
+void pbmPackRawRow(const unsigned char *bytes, int width, Bit2_word *span) {
+        int words = (width + BIT2_WORD_BITS - 1) / BIT2_WORD_BITS;
+        size_t rowBytes = (width + 7) / 8;
+
+        for (int w = 0; w < words; w++) {
+                Bit2_word word = 0;
+                size_t first = (size_t)w * sizeof(Bit2_word);
+                for (size_t b = 0; b < sizeof(Bit2_word) &&
+                     first + b < rowBytes; b++) {
+                        word |= (Bit2_word)reversedByte[bytes[first + b]] <<
+                                (8 * b);
+                }
+                span[w] = word;
+        }
+        /* the unused bits at the end of a raw row are not pixels */
+        if (width % BIT2_WORD_BITS != 0) {
+                span[words - 1] &= ((Bit2_word)1 << (width % BIT2_WORD_BITS))
+                                   - 1;
+        }
+}
+
+/**********pbmGetc********
+ *
+ * About: This function reads the next byte of a file or a buffer,
+ *        refilling the chunk of a file read a chunk at a time
+ * Inputs: 
+ * PbmInput *input: where the byte is read from
+ * Return: the byte, or EOF at the end of the input
+ ************************/
+int pbmGetc(PbmInput *input) {
+        if (input->fp != NULL && input->chunk == NULL) {
+                return getc(input->fp);
+        }
+        if (input->pos == input->length && !pbmRefill(input)) {
+                return EOF;
+        }
+        return input->data[input->pos++];
+}
+
+/**********pbmUngetc********
+ *
+ * About: This function pushes back the byte that was just read from a file
+ *        or a buffer
+ * Inputs: 
+ * PbmInput *input: where the byte was read from
+ * int c: the byte, or EOF
+ * Return: none
+ ************************/
+void pbmUngetc(PbmInput *input, int c) {
+        if (input->fp != NULL && input->chunk == NULL) {
+                ungetc(c, input->fp);
+        }
+        else if (c != EOF) {
+                input->pos--;
+        }
+}
+
+/**********pbmSkipSpace********
+ *
+ * About: This function skips whitespace and comments (from '#' to the end of
+ *        the line) in a pbm file
+ * Inputs: 
+ * PbmInput *input: the file or buffer being read
+ * Return: the first character that is not whitespace or part of a comment,
+ *         or EOF
+ ************************/
+int pbmSkipSpace(PbmInput *input) {
+        int c = pbmGetc(input);
+        while (c != EOF) {
+                if (c == '#') {
+                        while (c != '\n' && c != '\r' && c != EOF) {
+                                c = pbmGetc(input);
+                        }
+                }
+                else if (c != ' ' && c != '\t' && c != '\n' && c != '\r' &&
+                         c != '\v' && c != '\f') {
+                        break;
+                }
+                else {
+                        c = pbmGetc(input);
+                }
+        }
+        return c;
+}
+
+/**********pbmReadNumber********
+ *
+ * About: This function reads a nonnegative decimal number from the header of
+ *        a pbm file, skipping the whitespace and comments in front of it
+ * Inputs: 
+ * PbmInput *input: the file or buffer being read
+ * int *value: pointer to where the number is stored
+ * Return: true if a number that fits in an int was read, false otherwise
+ ************************/
+bool pbmReadNumber(PbmInput *input, int *value) {
+        int c = pbmSkipSpace(input);
+        if (c < '0' || c > '9') {
+                return false;
+        }
+        long number = 0;
+        while (c >= '0' && c <= '9') {
+                number = number * 10 + (c - '0');
+                if (number > INT32_MAX) {
+                        return false;
+                }
+                c = pbmGetc(input);
+        }
+        pbmUngetc(input, c);
+        *value = (int)number;
+        return true;
+}
+
+/**********pbmBadFormat********
+ *
+ * About: This function reports an input that is not a valid pbm file and
+ *        exits the program
+ * Inputs: 
+ * FILE *inputfp: the file being read, which is closed, or NULL when a
+ *                buffer was being read
+ * Bit2_T *bitmap: pointer to a partly filled bitmap to free, or NULL
+ * Return: does not return
+ ************************/
+void pbmBadFormat(FILE *inputfp, Bit2_T *bitmap) {
+        if (bitmap != NULL) {
+                Bit2_free(bitmap);
+        }
+        if (inputfp != NULL) {
+                fclose(inputfp);
+        }
+        fprintf(stderr, "pbm file promised but not delivered\n");
+        exit(EXIT_FAILURE);
+}
+
 /**********pbmWrite********
  *
- * About: This function prints the values in a 2D bit vector in the P1 format 
- *        to the output file. 
+ * About: This function prints the values in a 2D bit vector in the given pbm
+ *        format to the output file. Plain rows are rendered by arrayPrinter
+ *        into one text buffer that is written out whenever it is full. The
+ *        bitmap can be stored in either layout.
  * Inputs:
  * FILE *outputfp: a pointer to an output file where the output is printed at
  * Bit2_T bitmap: a 2D bitVector where the data is stored at
+ * int format: PBM_PLAIN to print a P1 file, PBM_RAW to print a P4 file
  * Return: none
  ************************/
-void pbmWrite(FILE *outputfp, Bit2_T bitmap) {
-        
-        /* obtaining the size info of the unblacked data in P1 format */
-        int width = Bit2_width(bitmap);
-        int height = Bit2_height(bitmap);
-        
+void pbmWrite(FILE *outputfp, Bit2_T bitmap, int format) {
+        assert(format == PBM_PLAIN || format == PBM_RAW);
+
         /* printing the header information to the output */
-        fprintf(outputfp, "P1\n%d %d\n", width, height);
+        pbmWriteHeader(outputfp, format, Bit2_width(bitmap), 
+                       Bit2_height(bitmap));
 
         /* printing the unblacked bitVector to the output */
-        Bit2_map_row_major(bitmap, arrayPrinter, outputfp);
+        if (format == PBM_RAW) {
+                pbmWriteRaw(outputfp, bitmap);
+        }
+        else {
+                size_t rowText = PBM_ROW_BUFFER(Bit2_width(bitmap));
+                PbmOutput output = { outputfp, NULL, 0, 0 };
+                output.capacity = rowText > PBM_TEXT_BUFFER ? rowText :
+                                  PBM_TEXT_BUFFER;
+                output.text = ALLOC(output.capacity);
+                Bit2_map_rows(bitmap, arrayPrinter, &output);
+                fwrite(output.text, 1, output.length, outputfp);
+                FREE(output.text);
+        }
+}
+
+/**********pbmWriteHeader********
+ *
+ * About: This function prints the header of a pbm file
+ * Inputs:
+ * FILE *outputfp: a pointer to an output file where the output is printed at
+ * int format: PBM_PLAIN or PBM_RAW
+ * int width: the number of cols of the image
+ * int height: the number of rows of the image
+ * Return: none
+ ************************/
+void pbmWriteHeader(FILE *outputfp, int format, int width, int height) {
+        assert(format == PBM_PLAIN || format == PBM_RAW);
+        fprintf(outputfp, "P%d\n%d %d\n", format, width, height);
+}
+
+/**********pbmRenderHeader********
+ *
+ * About: This function renders the header pbmWriteHeader prints as text
+ * Inputs:
+ * char *text: where the text is stored, with room for PBM_HEADER_TEXT bytes
+ * int format: PBM_PLAIN or PBM_RAW
+ * int width: the number of cols of the image
+ * int height: the number of rows of the image
+ * Return: the number of bytes of the header, not counting the '\0' stored
+ *         after it
+ ************************/
+int pbmRenderHeader(char *text, int format, int width, int height) {
+        return snprintf(text, PBM_HEADER_TEXT, "P%d\n%d %d\n", format, width,
+                        height);
+}
+
+/**********pbmEncodedSize********
+ *
+ * About: This function computes the number of bytes pbmWrite prints for an
+ *        image of the given size
+ * Inputs:
+ * int format: PBM_PLAIN or PBM_RAW
+ * int width: the number of cols of the image, at least 1
+ * int height: the number of rows of the image, at least 1
+ * Return: the size of the pbm file in bytes
+ ************************/
+size_t pbmEncodedSize(int format, int width, int height) {
+        assert(format == PBM_PLAIN || format == PBM_RAW);
+
+        char header[PBM_HEADER_TEXT];
+        size_t rowBytes = format == PBM_RAW ? ((size_t)width + 7) / 8 :
+                          PBM_ROW_BUFFER(width);
+        return pbmRenderHeader(header, format, width, height) +
+               rowBytes * height;
+}
+
+/**********pbmWriteBuffer********
+ *
+ * About: This function stores the same bytes pbmWrite prints into a buffer
+ *        in memory instead of a file
+ * Inputs:
+ * unsigned char *out: where the bytes are stored
+ * Bit2_T bitmap: a 2D bitVector stored in rows
+ * int format: PBM_PLAIN or PBM_RAW
+ * Return: the number of bytes stored
+ * Expects: 
+ * - out and bitmap to be non-null, and out to have room for
+ *   pbmEncodedSize(format, width, height) bytes
+ ************************/
+size_t pbmWriteBuffer(unsigned char *out, Bit2_T bitmap, int format) {
+        assert(out != NULL && bitmap != NULL);
+        assert(format == PBM_PLAIN || format == PBM_RAW);
+
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        char header[PBM_HEADER_TEXT];
+        size_t length = pbmRenderHeader(header, format, width, height);
+        memcpy(out, header, length);
+
+        for (int row = 0; row < height; row++) {
+                const Bit2_word *span = Bit2_row(bitmap, row);
+                length += format == PBM_RAW ?
+                          pbmRenderRawRow(out + length, width, span) :
+                          pbmRenderPlainRow((char *)out + length, width, span);
+        }
+        return length;
+}
+
+/**********pbmWriteRaw********
+ *
+ * About: This function prints the rows of a 2D bit vector as packed raw (P4)
+ *        rows, one row at a time with pbmWriteRow. The rows of a blocked
+ *        bitmap are gathered from its blocks into a span first.
+ * Inputs:
+ * FILE *outputfp: a pointer to an output file where the output is printed at
+ * Bit2_T bitmap: a 2D bitVector where the data is stored at
+ * Return: none
+ * Expects: 
+ * - outputfp and bitmap to be non-null
+ ************************/
+void pbmWriteRaw(FILE *outputfp, Bit2_T bitmap) {
+        assert(outputfp != NULL && bitmap != NULL);
+
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+        unsigned char *bytes = ALLOC((width + 7) / 8);
+        bool blocked = Bit2_layout(bitmap) == BIT2_BLOCKED;
+        Bit2_word *scratch = blocked ? CALLOC((width + BIT2_WORD_BITS - 1) /
+                                              BIT2_WORD_BITS,
+                                              sizeof(Bit2_word)) : NULL;
+
+        for (int row = 0; row < height; row++) {
+                const Bit2_word *span = scratch;
+                if (blocked) {
+                        Bit2_get_row(bitmap, row, scratch);
+                }
+                else {
+                        span = Bit2_row(bitmap, row);
+                }
+                pbmWriteRow(outputfp, PBM_RAW, width, span, bytes);
+        }
+        FREE(bytes);
+        if (blocked) {
+                FREE(scratch);
+        }
+}
+
+/**********pbmWriteRow********
+ *
+ * About: This function prints one row span in the given pbm format with a
+ *        single fwrite. The words of a raw row are bit-reversed into the
+ *        byte buffer, and a plain row is rendered into it as text ending
+ *        with a new line by pbmRenderPlainRow.
+ * Inputs:
+ * FILE *outputfp: a pointer to an output file where the output is printed at
+ * int format: PBM_PLAIN or PBM_RAW
+ * int width: the number of bits in the row
+ * const Bit2_word *span: the words holding the row
+ * unsigned char *bytes: a buffer of PBM_ROW_BUFFER(width) bytes, or of
+ *                       (width + 7) / 8 bytes if only raw rows are printed
+ * Return: none
+ * Expects: 
+ * - outputfp, span and bytes to be non-null
+ ************************/
+void pbmWriteRow(FILE *outputfp, int format, int width, 
+                 const Bit2_word *span, unsigned char *bytes) {
+        assert(outputfp != NULL && span != NULL && bytes != NULL);
+
+        if (format == PBM_PLAIN) {
+                fwrite(bytes, 1, pbmRenderPlainRow((char *)bytes, width, span),
+                       outputfp);
+                return;
+        }
+        fwrite(bytes, 1, pbmRenderRawRow(bytes, width, span), outputfp);
+}
+
+/**********pbmRenderRawRow********
+ *
+ * About: This function packs one row span into raw pbm bytes, bit-reversing
+ *        the bytes of its words
+ * Inputs:
+ * unsigned char *bytes: where the bytes are stored, with room for
+ *                       (width + 7) / 8 bytes
+ * int width: the number of bits in the row
+ * const Bit2_word *span: the words holding the row
+ * Return: the number of bytes stored, (width + 7) / 8
+ ************************/
+size_t pbmRenderRawRow(unsigned char *bytes, int width,
+                       const Bit2_word *span) {
+        size_t rowBytes = (width + 7) / 8;
+        for (size_t b = 0; b < rowBytes; b++) {
+                Bit2_word word = span[b / sizeof(Bit2_word)];
+                bytes[b] = reversedByte[(word >> (8 * (b % 
+                           sizeof(Bit2_word)))) & 0xff];
+        }
+        return rowBytes;
+}
+
+/**********pbmRenderPlainRow********
+ *
+ * About: This function renders one row span as plain pbm text followed by
+ *        a new line, copying the text of 8 bits at a time from byteText
+ * Inputs:
+ * char *text: where the text is stored, with room for width + 1 bytes
+ * int width: the number of bits in the row
+ * const Bit2_word *span: the words holding the row
+ * Return: the number of bytes stored, width + 1
+ ************************/
+size_t pbmRenderPlainRow(char *text, int width, const Bit2_word *span) {
+        int fullBytes = width / 8;
+        for (int b = 0; b < fullBytes; b++) {
+                Bit2_word word = span[b / sizeof(Bit2_word)];
+                unsigned byte = (word >> (8 * (b % sizeof(Bit2_word)))) & 0xff;
+                memcpy(text + 8 * b, byteText[byte], 8);
+        }
+        if (width % 8 != 0) {
+                Bit2_word word = span[fullBytes / sizeof(Bit2_word)];
+                unsigned byte = (word >> (8 * (fullBytes % sizeof(Bit2_word))))
+                                & 0xff;
+                memcpy(text + 8 * fullBytes, byteText[byte], width % 8);
+        }
+        text[width] = '\n';
+        return (size_t)width + 1;
 }
 
 /**********arrayFiller********
  *
- * About: This function is an apply function for Bit2_map_row_major. It is 
- *        used to get a single data from the *p1 pointer (a Pnmrdr_T object)
- *        and put that data in the Bit2_T array at the given row and col
- *        indices
+ * About: This function is an apply function for Bit2_map_rows. It is used
+ *        to read a whole row of bits from the *p1 pointer (a plain pbm file)
+ *        into the span of that row of the Bit2_T array
  * Inputs:
- * int col: the column value of the index where the data is going to be put at
- * int row: the row value of the index where the data is going to be put at
+ * int row: the index of the row being read
+ * Bit2_word *span: the words of the row where the bits are put
+ * int words: the number of words in span
  * Bit2_T array: a 2D Bit2_T object where the whole data is stored at
- * int bit: integer value of the current data being visited
- * void *p1: pointer to an object where the data is read from ( Pnmrdr_T
- *           object for this program)
+ * void *p1: pointer to an object where the data is read from (a PbmInput
+ *           positioned at the row in a plain pbm file)
  * Return: none
  * Expects: 
  * - *p1 to be non-null which is handled in the pbmRead function
+ * - the next bits in the file to be '0's or '1's, otherwise the program
+ *   exits as the input is not a valid pbm file
  ************************/
-void arrayFiller(int col, int row, Bit2_T array, int bit, void *p1) {
-        (void) bit;
+void arrayFiller(int row, Bit2_word *span, int words, Bit2_T array, 
+                 void *p1) {
+        (void) row;
+        (void) words;
 
-        /* reading the initial data from p1 and filling out 2D bit vector */
-        unsigned num = Pnmrdr_get(p1);
-        Bit2_put(array, col, row, num);
+        /* reading the next row from p1 and filling out 2D bit vector */
+        PbmInput *input = p1;
+        if (!pbmReadPlainRow(input, Bit2_width(array), span)) {
+                pbmBadFormat(input->fp, &array);
+        }
 }
 
 /**********arrayPrinter********
  *
- * About: This function is an apply function for Bit2_map_row_major. It is 
- *        used to print out the data to the given output file
+ * About: This function is an apply function for Bit2_map_rows. It is used
+ *        to render a whole row of the data as plain pbm text into the
+ *        buffer of the given output, writing the buffer to its file first
+ *        when the row does not fit
  * Inputs:
- * int col: the column value of the data that is to be printed
- * int row: the row value of the data that is to be printed
+ * int row: the index of the row being printed
+ * Bit2_word *span: the words of the row
+ * int words: the number of words in span
  * Bit2_T array: a 2D Bit2_T object where the whole data is stored at
- * int bit: integer value of the current data being visited
- * void *p1: pointer to an object where the output data is printed at (an
- *           output file for this program)
+ * void *p1: pointer to a PbmOutput whose buffer has room for at least one
+ *           row; the caller writes out what is left in it at the end
  * Return: none
  * Expects: 
  * - *p1 to be non-null 
  ************************/
-void arrayPrinter(int col, int row, Bit2_T array, int bit, void *p1) {
-
-        (void) bit;
+void arrayPrinter(int row, Bit2_word *span, int words, Bit2_T array,
+                  void *p1) {
+        (void) row;
+        (void) words;
         assert(p1 != NULL);
 
-        /* printing the data utilizing the Bit2_get function */
-        fprintf(p1, "%d", Bit2_get(array, col, row));
-
-        /* printing a new line after done printing one row */
-        if (col == Bit2_width(array) - 1)
-                fprintf(p1, "\n");
-}
\ No newline at end of file
+        /* rendering the row followed by a new line */
+        PbmOutput *output = p1;
+        int width = Bit2_width(array);
+        if (output->capacity - output->length < PBM_ROW_BUFFER(width)) {
+                fwrite(output->text, 1, output->length, output->fp);
+                output->length = 0;
+        }
+        output->length += pbmRenderPlainRow(output->text + output->length,
+                                            width, span);
+}
@@ -6,7 +6,8 @@
  *     About: This program checks if a given file is in the correct pbm format.
  *            If it is, the program creates a 2D vector to store the data.
  *            The program can also be used to print out the cleared data in
- *            the 2D vector to an output file.
+ *            the 2D vector to an output file. Both plain (P1) and raw (P4)
+ *            bitmaps are read.
  *     
  */
 
@@ -15,11 +16,82 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <bit2.h>
 
+/* magic numbers of the two pbm flavours: plain (ASCII) and raw (packed) */
+#define PBM_PLAIN 1
+#define PBM_RAW 4
+
+/* size of the buffer pbmWriteRow needs for a row of either format: one
+ * character per bit and a new line for plain rows, which is more than the
+ * (width + 7) / 8 bytes of a raw row */
+#define PBM_ROW_BUFFER(width) ((size_t)(width) + 1)
+
+/* what pbmReadBuffer found: an image, a bad file, or no memory for it */
+typedef enum {
+        PBM_READ_OK, PBM_READ_BAD, PBM_READ_NO_MEMORY
+} PbmReadStatus;
+
+/**********struct PbmHeader********
+ * About: This struct holds the information read from the header of a pbm
+ *        file.
+************************/
+typedef struct PbmHeader {
+        int format; /* PBM_PLAIN or PBM_RAW */
+        int width; /* number of cols in the image, at least 1 */
+        int height; /* number of rows in the image, at least 1 */
+} PbmHeader;
+
+/**********struct PbmInput********
+ * About: This struct holds where pbm data is read from, which is either a
+ *        file, a buffer in memory, or a file read a chunk at a time into a
+ *        buffer that is refilled as it runs out.
+************************/
+typedef struct PbmInput {
+        FILE *fp; /* the file to read, or NULL to read the buffer */
+        const unsigned char *data; /* the buffer to read when fp is NULL
+                                      or chunk is set */
+        size_t length; /* number of bytes in the buffer */
+        size_t pos; /* index of the next byte of the buffer to read */
+        unsigned char *chunk; /* the buffer fp is read into, or NULL to
+                                 read fp a byte at a time */
+        size_t capacity; /* number of bytes that fit in chunk */
+} PbmInput;
+
+/**********struct PbmOutput********
+ * About: This struct holds a buffer of plain pbm text waiting to be written
+ *        to a file, so that many rows are written with a single fwrite.
+************************/
+typedef struct PbmOutput {
+        FILE *fp; /* the file the text is written to */
+        char *text; /* the buffered text */
+        size_t length; /* number of bytes in text */
+        size_t capacity; /* number of bytes that fit in text */
+} PbmOutput;
+
 Bit2_T pbmRead (FILE *inputfp);
-void pbmWrite(FILE *outputfp, Bit2_T bitmap);
-void arrayFiller(int col, int row, Bit2_T array, int bit, void *p1);
-void arrayPrinter(int col, int row, Bit2_T array, int bit, void *p1);
+Bit2_T pbmReadLayout(FILE *inputfp, Bit2_Layout layout);
+Bit2_T pbmReadMapped(const unsigned char *data, size_t length);
+Bit2_T pbmReadMappedLayout(const unsigned char *data, size_t length,
+                           Bit2_Layout layout);
+PbmReadStatus pbmReadBuffer(const unsigned char *data, size_t length,
+                            Bit2_T bitmap);
+bool pbmReadHeader(FILE *inputfp, PbmHeader *header);
+bool pbmReadRaw(FILE *inputfp, Bit2_T bitmap);
+bool pbmReadRow(FILE *inputfp, int format, int width, Bit2_word *span,
+                unsigned char *bytes);
+void pbmBadFormat(FILE *inputfp, Bit2_T *bitmap);
+void pbmWrite(FILE *outputfp, Bit2_T bitmap, int format);
+void pbmWriteHeader(FILE *outputfp, int format, int width, int height);
+size_t pbmEncodedSize(int format, int width, int height);
+size_t pbmWriteBuffer(unsigned char *out, Bit2_T bitmap, int format);
+void pbmWriteRaw(FILE *outputfp, Bit2_T bitmap);
+void pbmWriteRow(FILE *outputfp, int format, int width, 
+                 const Bit2_word *span, unsigned char *bytes);
+void arrayFiller(int row, Bit2_word *span, int words, Bit2_T array,
+                 void *p1);
+void arrayPrinter(int row, Bit2_word *span, int words, Bit2_T array,
+                  void *p1);
 
 #endif
\ No newline at end of file
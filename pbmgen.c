@@ -0,0 +1,59 @@
+/*
+ *     pbmgen.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This program writes a synthetic pbm file made by pbmGenerate to
+ *     stdout, so the benchmark bitmaps can also be given to unblackedges.
+ *     usage: pbmgen [-r] frame|spiral|noise width height [density [seed]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <bit2.h>
+#include <pbmReadWrite.h>
+#include <pbmGen.h>
+
+/**********main********
+ *
+ * About: Reads the kind, size, density and seed of the bitmap from the
+ *        arguments, generates it and prints it as a plain (P1) pbm file,
+ *        or as a raw (P4) one with the -r option. The density defaults to
+ *        0.5 and the seed to 1.
+ * Inputs:
+ * int argc: number of given arguments to start the program
+ * char *argv: an array that stores the arguments
+ * Return: EXIT_SUCCESS if the bitmap is written, EXIT_FAILURE on bad
+ *         arguments
+ ************************/
+int main(int argc, char *argv[]) {
+        int format = PBM_PLAIN;
+        if (argc > 1 && strcmp(argv[1], "-r") == 0) {
+                format = PBM_RAW;
+                argv[1] = argv[0];
+                argv++;
+                argc--;
+        }
+
+        PbmGenKind kind;
+        int width = argc > 2 ? atoi(argv[2]) : 0;
+        int height = argc > 3 ? atoi(argv[3]) : 0;
+        double density = argc > 4 ? atof(argv[4]) : 0.5;
+        uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : 1;
+
+        if (argc < 4 || argc > 6 || !pbmGenParse(argv[1], &kind) ||
+            width <= 0 || height <= 0 || density < 0 || density > 1) {
+                fprintf(stderr, "usage: %s [-r] frame|spiral|noise width "
+                        "height [density [seed]]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+
+        Bit2_T bitmap = pbmGenerate(kind, width, height, density, seed);
+        pbmWrite(stdout, bitmap, format);
+        Bit2_free(&bitmap);
+
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+/*
+ *     pool.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file is used to create a pool of memory. The pool holds a
+ *     list of chunks in use, the newest first, and a list of spare chunks
+ *     left over from the last reset. A block is cut from the end of the
+ *     newest chunk when it fits; otherwise a spare chunk that is large
+ *     enough is put back in use, or a new chunk of at least the chunk size
+ *     of the pool is allocated. Every block is aligned for any type. The
+ *     chunks come from malloc rather than Mem, so running out of memory
+ *     comes back as NULL.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pool.h>
+
+#define T Pool_T
+
+/* the types whose alignment a block must respect */
+union PoolAlign {
+        long l;
+        long long ll;
+        double d;
+        long double ld;
+        void *p;
+        void (*f)(void);
+};
+
+/* rounds a size up to a whole number of alignment units */
+#define POOL_ROUND(n) (((n) + (long)sizeof(union PoolAlign) - 1) / \
+                       (long)sizeof(union PoolAlign) * \
+                       (long)sizeof(union PoolAlign))
+
+/**********struct Chunk********
+ * About: This struct is the header of a chunk, whose blocks follow it
+************************/
+typedef struct Chunk {
+        struct Chunk *next; /* the next chunk of the same list */
+        long size; /* number of bytes for blocks after the header */
+        long used; /* number of those bytes handed out */
+} Chunk;
+
+/* the blocks of a chunk start after its header, rounded up */
+#define CHUNK_HEADER POOL_ROUND((long)sizeof(Chunk))
+
+/**********struct T********
+ * About: This struct holds the chunks of a pool
+************************/
+struct T {
+        Chunk *chunks; /* the chunks in use, the newest first */
+        Chunk *spare; /* the chunks released by the last reset */
+        long chunkSize; /* the smallest number of bytes of a new chunk */
+        long used; /* number of bytes handed out since the last reset */
+        long size; /* number of bytes held in all the chunks */
+};
+
+/**********Pool_new********
+ * About: This function creates an empty pool
+ * Inputs:
+ * long chunkSize: the number of bytes of block space in each chunk; larger
+ *                 blocks get a chunk of their own size
+ * Return: an empty pool, which allocates no chunk until it is first used, or
+ *         NULL if there is not enough memory
+ * Expects
+ * - chunkSize to be greater than 0
+************************/
+T Pool_new(long chunkSize) {
+        assert(chunkSize > 0);
+
+        T pool = malloc(sizeof(*pool));
+        if (pool == NULL) {
+                return NULL;
+        }
+        pool->chunks = NULL;
+        pool->spare = NULL;
+        pool->chunkSize = POOL_ROUND(chunkSize);
+        pool->used = 0;
+        pool->size = 0;
+        return pool;
+}
+
+/**********Pool_alloc********
+ * About: This function hands out a block of the given size from the pool
+ * Inputs:
+ * T pool: the pool
+ * long nbytes: the size of the block
+ * Return: the block, aligned for any type and uninitialized, which stays
+ *         valid until the pool is reset or freed, or NULL if a new chunk
+ *         was needed and there is not enough memory for it
+ * Expects
+ * - pool to be non-null and nbytes to be greater than 0
+************************/
+void *Pool_alloc(T pool, long nbytes) {
+        assert(pool != NULL);
+        assert(nbytes > 0);
+
+        nbytes = POOL_ROUND(nbytes);
+        Chunk *chunk = pool->chunks;
+        if (chunk == NULL || chunk->size - chunk->used < nbytes) {
+                /* reusing a spare chunk that fits, or making a new one */
+                Chunk **link = &pool->spare;
+                while (*link != NULL && (*link)->size < nbytes) {
+                        link = &(*link)->next;
+                }
+                chunk = *link;
+                if (chunk != NULL) {
+                        *link = chunk->next;
+                }
+                else {
+                        long size = nbytes > pool->chunkSize ? nbytes :
+                                    pool->chunkSize;
+                        chunk = malloc(CHUNK_HEADER + size);
+                        if (chunk == NULL) {
+                                return NULL;
+                        }
+                        chunk->size = size;
+                        pool->size += size;
+                }
+                chunk->used = 0;
+                chunk->next = pool->chunks;
+                pool->chunks = chunk;
+        }
+
+        void *block = (char *)chunk + CHUNK_HEADER + chunk->used;
+        chunk->used += nbytes;
+        pool->used += nbytes;
+        return block;
+}
+
+/**********Pool_calloc********
+ * About: This function hands out a block for an array from the pool, with
+ *        every byte set to 0
+ * Inputs:
+ * T pool: the pool
+ * long count: the number of elements
+ * long nbytes: the size of an element
+ * Return: the block, which stays valid until the pool is reset or freed, or
+ *         NULL if there is not enough memory
+ * Expects
+ * - pool to be non-null and count and nbytes to be greater than 0
+************************/
+void *Pool_calloc(T pool, long count, long nbytes) {
+        assert(count > 0 && nbytes > 0);
+        void *block = Pool_alloc(pool, count * nbytes);
+        if (block != NULL) {
+                memset(block, 0, count * nbytes);
+        }
+        return block;
+}
+
+/**********Pool_reset********
+ * About: This function releases every block of the pool at once. The
+ *        chunks are kept as spares for the blocks handed out next.
+ * Inputs:
+ * T pool: the pool
+ * Return: none
+ * Expects
+ * - pool to be non-null
+************************/
+void Pool_reset(T pool) {
+        assert(pool != NULL);
+        while (pool->chunks != NULL) {
+                Chunk *chunk = pool->chunks;
+                pool->chunks = chunk->next;
+                chunk->next = pool->spare;
+                pool->spare = chunk;
+        }
+        pool->used = 0;
+}
+
+/**********Pool_used********
+ * About: This function returns the number of bytes handed out since the
+ *        pool was created or last reset
+ * Inputs:
+ * T pool: the pool
+ * Return: the number of bytes, alignment padding included
+ * Expects
+ * - pool to be non-null
+************************/
+long Pool_used(T pool) {
+        assert(pool != NULL);
+        return pool->used;
+}
+
+/**********Pool_size********
+ * About: This function returns the number of bytes held by the chunks of
+ *        the pool, in use or spare
+ * Inputs:
+ * T pool: the pool
+ * Return: the number of bytes, chunk headers left out
+ * Expects
+ * - pool to be non-null
+************************/
+long Pool_size(T pool) {
+        assert(pool != NULL);
+        return pool->size;
+}
+
+/**********Pool_free********
+ * About: This function frees the pool with all of its chunks
+ * Inputs:
+ * T *pool: address of the pool
+ * Return: none
+ * Expects
+ * - pool and *pool to be non-null
+************************/
+void Pool_free(T *pool) {
+        assert(pool != NULL && *pool != NULL);
+
+        Pool_reset(*pool);
+        while ((*pool)->spare != NULL) {
+                Chunk *chunk = (*pool)->spare;
+                (*pool)->spare = chunk->next;
+                free(chunk);
+        }
+        free(*pool);
+        *pool = NULL;
+}
+
+#undef POOL_ROUND
+#undef CHUNK_HEADER
+#undef T
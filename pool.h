@@ -0,0 +1,34 @@
+/*
+ *     pool.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to create a pool of memory that hands out
+ *     blocks by moving a pointer through large chunks. The blocks are never
+ *     freed one by one: resetting the pool releases all of them at once and
+ *     keeps the chunks for the next round, so a client cleaning one image
+ *     after another stops allocating once the largest image has been seen.
+ *     Unlike Hanson's Arena, whose free chunks are shared by every arena, a
+ *     pool shares nothing with other pools, so threads that each use their
+ *     own pool need no locking. A pool that cannot get memory returns NULL
+ *     instead of raising Mem_Failed, so it can be used where an exception
+ *     could not be caught.
+ *
+ */
+
+#ifndef POOL_INCLUDED
+#define POOL_INCLUDED
+
+#define T Pool_T
+typedef struct T *T;
+
+extern T Pool_new(long chunkSize);
+extern void *Pool_alloc(T pool, long nbytes);
+extern void *Pool_calloc(T pool, long count, long nbytes);
+extern void Pool_reset(T pool);
+extern long Pool_used(T pool);
+extern long Pool_size(T pool);
+extern void Pool_free(T *pool);
+
+#undef T
+#endif
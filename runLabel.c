@@ -0,0 +1,243 @@
+/*
+ *     runLabel.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file labels the black runs of a band of rows of a Bit2_T
+ *     bitmap. The runs of each row are found with word scans of the row
+ *     span, and every run is joined in a union-find forest with the runs of
+ *     the previous row that it overlaps. Roots are always the smallest label
+ *     of their tree, which keeps the labels of a component in raster order.
+ *     The runs are counted first, from the words where a black bit follows
+ *     a white one, so the arrays are taken from the pool at their final
+ *     size.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <bit2.h>
+#include <pool.h>
+#include <spanFill.h>
+#include <runLabel.h>
+
+/**********RunLabels_count********
+ * About: This function counts the black runs of the given band of rows
+ * without allocating anything
+ * Inputs:
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * int firstRow: index of the first row of the band
+ * int rows: number of rows in the band, at least 1
+ * Return: the number of runs in the band
+ * Expects
+ * - bitmap to be non-null and stored in BIT2_ROWS
+ * - the band to be within the rows of the bitmap
+************************/
+long RunLabels_count(Bit2_T bitmap, int firstRow, int rows) {
+        assert(bitmap != NULL);
+        assert(firstRow >= 0 && rows > 0 &&
+               firstRow + rows <= Bit2_height(bitmap));
+
+        int words = Bit2_row_words(bitmap);
+        long runs = 0;
+        for (int row = firstRow; row < firstRow + rows; row++) {
+                const Bit2_word *span = Bit2_row(bitmap, row);
+
+                /* a run starts at every black bit whose left bit is white */
+                Bit2_word carry = 0;
+                for (int w = 0; w < words; w++) {
+                        Bit2_word starts = span[w] & ~(span[w] << 1 | carry);
+                        carry = span[w] >> (BIT2_WORD_BITS - 1);
+                        runs += __builtin_popcountll(starts);
+                }
+        }
+        return runs;
+}
+
+/**********RunLabels_alloc********
+ * About: This function takes the arrays of a band from a pool, with room
+ * for the given number of runs, and leaves the band empty
+ * Inputs:
+ * RunLabels *labels: the struct to set up
+ * int firstRow: index of the first row of the band
+ * int rows: number of rows in the band, at least 1
+ * long runs: the number of runs of the band, from RunLabels_count
+ * Pool_T pool: the pool the arrays are taken from, which frees them when
+ *              it is reset
+ * Return: true if the arrays were taken, false if the pool ran out of
+ *         memory
+ * Expects
+ * - labels and pool to be non-null
+************************/
+bool RunLabels_alloc(RunLabels *labels, int firstRow, int rows, long runs,
+                     Pool_T pool) {
+        assert(labels != NULL && pool != NULL);
+        assert(rows > 0 && runs >= 0);
+
+        labels->firstRow = firstRow;
+        labels->rows = rows;
+        labels->length = 0;
+        labels->capacity = runs;
+        labels->rowStart = Pool_alloc(pool, (long)(rows + 1) * sizeof(long));
+        labels->first = NULL;
+        labels->last = NULL;
+        labels->parent = NULL;
+        if (runs > 0) {
+                labels->first = Pool_alloc(pool, runs * sizeof(int));
+                labels->last = Pool_alloc(pool, runs * sizeof(int));
+                labels->parent = Pool_alloc(pool, runs * sizeof(long));
+        }
+        return labels->rowStart != NULL && (runs == 0 ||
+               (labels->first != NULL && labels->last != NULL &&
+                labels->parent != NULL));
+}
+
+/**********RunLabels_fill********
+ * About: This function finds the black runs of the band of a struct set up
+ * by RunLabels_alloc and joins the runs of neighbouring rows that touch
+ * each other. Nothing is allocated, so it can run on any thread.
+ * Inputs:
+ * RunLabels *labels: the band
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * Return: none
+ * Expects
+ * - labels and bitmap to be non-null
+ * - the band to have room for all of its runs
+************************/
+void RunLabels_fill(RunLabels *labels, Bit2_T bitmap) {
+        assert(labels != NULL && bitmap != NULL);
+
+        int words = Bit2_row_words(bitmap);
+        int firstRow = labels->firstRow;
+        labels->length = 0;
+        labels->rowStart[0] = 0;
+
+        for (int i = 0; i < labels->rows; i++) {
+                const Bit2_word *span = Bit2_row(bitmap, firstRow + i);
+
+                /* finding every run of the row from left to right */
+                int col = spanNextBlack(span, 0, words);
+                while (col != -1) {
+                        int last = spanRunEnd(span, col, words);
+                        long run = labels->length++;
+                        assert(run < labels->capacity);
+                        labels->first[run] = col;
+                        labels->last[run] = last;
+                        labels->parent[run] = run;
+                        col = spanNextBlack(span, last + 1, words);
+                }
+                labels->rowStart[i + 1] = labels->length;
+
+                if (i > 0) {
+                        RunLabels_join(labels->parent, labels, 0,
+                                       firstRow + i - 1, labels, 0,
+                                       firstRow + i);
+                }
+        }
+}
+
+/**********RunLabels_init********
+ * About: This function counts, allocates and fills the runs of the given
+ * band of rows in one call
+ * Inputs:
+ * RunLabels *labels: the struct to fill
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * int firstRow: index of the first row of the band
+ * int rows: number of rows in the band, at least 1
+ * Pool_T pool: the pool the arrays are taken from
+ * Return: true if the runs were labelled, false if the pool ran out of
+ *         memory
+ * Expects
+ * - labels, bitmap and pool to be non-null
+ * - the band to be within the rows of the bitmap
+************************/
+bool RunLabels_init(RunLabels *labels, Bit2_T bitmap, int firstRow,
+                    int rows, Pool_T pool) {
+        long runs = RunLabels_count(bitmap, firstRow, rows);
+        if (!RunLabels_alloc(labels, firstRow, rows, runs, pool)) {
+                return false;
+        }
+        RunLabels_fill(labels, bitmap);
+        return true;
+}
+
+/**********RunLabels_find********
+ * About: This function finds the root of the tree that holds a label,
+ * halving the path to the root on the way
+ * Inputs:
+ * long *parent: the union-find parents
+ * long label: the label to find the root of
+ * Return: the root label
+************************/
+long RunLabels_find(long *parent, long label) {
+        while (parent[label] != label) {
+                parent[label] = parent[parent[label]];
+                label = parent[label];
+        }
+        return label;
+}
+
+/**********RunLabels_union********
+ * About: This function joins the trees that hold the two labels, making the
+ * smaller root the root of both
+ * Inputs:
+ * long *parent: the union-find parents
+ * long label1: a label of the first tree
+ * long label2: a label of the second tree
+ * Return: none
+************************/
+void RunLabels_union(long *parent, long label1, long label2) {
+        long root1 = RunLabels_find(parent, label1);
+        long root2 = RunLabels_find(parent, label2);
+
+        if (root1 < root2) {
+                parent[root2] = root1;
+        }
+        else if (root2 < root1) {
+                parent[root1] = root2;
+        }
+}
+
+/**********RunLabels_join********
+ * About: This function joins every run of a row with the runs of the row
+ * below it that share a column with it. Both rows hold their runs from left
+ * to right, so they are walked together like a merge. The labels of each
+ * band are moved by the given offset, which lets bands that were labelled
+ * on their own be joined in one forest.
+ * Inputs:
+ * long *parent: the union-find parents, indexed by offset labels
+ * const RunLabels *upper: the band holding the upper row
+ * long upperOffset: the offset of the labels of the upper band
+ * int upperRow: index of the upper row in the bitmap
+ * const RunLabels *lower: the band holding the lower row
+ * long lowerOffset: the offset of the labels of the lower band
+ * int lowerRow: index of the lower row, which is upperRow + 1
+ * Return: none
+ * Expects
+ * - both rows to be in their bands
+************************/
+void RunLabels_join(long *parent, const RunLabels *upper, long upperOffset,
+                    int upperRow, const RunLabels *lower, long lowerOffset,
+                    int lowerRow) {
+        assert(lowerRow == upperRow + 1);
+
+        long a = upper->rowStart[upperRow - upper->firstRow];
+        long aEnd = upper->rowStart[upperRow - upper->firstRow + 1];
+        long b = lower->rowStart[lowerRow - lower->firstRow];
+        long bEnd = lower->rowStart[lowerRow - lower->firstRow + 1];
+
+        while (a < aEnd && b < bEnd) {
+                if (upper->first[a] <= lower->last[b] &&
+                    lower->first[b] <= upper->last[a]) {
+                        RunLabels_union(parent, upperOffset + a,
+                                        lowerOffset + b);
+                }
+                /* moving past whichever run ends first */
+                if (upper->last[a] < lower->last[b]) {
+                        a++;
+                }
+                else {
+                        b++;
+                }
+        }
+}
@@ -0,0 +1,54 @@
+/*
+ *     runLabel.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to label the black runs of a band of rows
+ *     of a Bit2_T bitmap. Every horizontal run of black bits gets a label,
+ *     and runs that touch each other in neighbouring rows are joined in a
+ *     union-find forest, so the runs with the same root make up one black
+ *     component. Bands labelled separately can be joined along their shared
+ *     rows once their labels are placed in one forest. The runs of a band
+ *     are counted before its arrays are taken from a Pool_T, so the arrays
+ *     never grow and resetting the pool frees them; a band can also be
+ *     counted and filled on another thread than the one owning the pool.
+ *
+ */
+
+#ifndef RUNLABEL_INCLUDED
+#define RUNLABEL_INCLUDED
+
+#include <stdbool.h>
+#include <bit2.h>
+#include <pool.h>
+
+/**********struct RunLabels********
+ * About: This struct holds the black runs of a band of rows, in row major
+ *        order, and the union-find parents of their labels.
+************************/
+typedef struct RunLabels {
+        int firstRow; /* index of the first row of the band */
+        int rows; /* number of rows in the band */
+        long length; /* number of runs in the band */
+        long capacity; /* number of runs the arrays were allocated for */
+        long *rowStart; /* runs of row firstRow + i are rowStart[i] up to
+                           rowStart[i + 1], rows + 1 entries */
+        int *first; /* first column of each run */
+        int *last; /* last column of each run */
+        long *parent; /* union-find parent of each run label */
+} RunLabels;
+
+extern long RunLabels_count(Bit2_T bitmap, int firstRow, int rows);
+extern bool RunLabels_alloc(RunLabels *labels, int firstRow, int rows,
+                            long runs, Pool_T pool);
+extern void RunLabels_fill(RunLabels *labels, Bit2_T bitmap);
+extern bool RunLabels_init(RunLabels *labels, Bit2_T bitmap, int firstRow,
+                           int rows, Pool_T pool);
+extern long RunLabels_find(long *parent, long label);
+extern void RunLabels_union(long *parent, long label1, long label2);
+extern void RunLabels_join(long *parent, const RunLabels *upper,
+                           long upperOffset, int upperRow,
+                           const RunLabels *lower, long lowerOffset,
+                           int lowerRow);
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ *     spanFill.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds a scanline flood fill that clears the black
+ *     edges of a Bit2_T bitmap. Each black edge bit seeds a fill. A fill
+ *     finds the whole horizontal run of black bits around its seed using the
+ *     row spans of the bitmap, clears the run with word masks, and pushes one
+ *     seed for every black run overlapping it in the rows above and below.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <bit2.h>
+#include <frontier.h>
+#include <spanFill.h>
+
+/* mask of the bits of a word at and above the given bit index */
+#define BITS_FROM(b) (~(Bit2_word)0 << (b))
+
+/**********spanClearEdges********
+ * About: This function clears every black bit that is connected to an edge
+ * of the bitmap. All black runs of the first and last rows and the black
+ * bits of the first and last cols are pushed as seeds, and the runs reached
+ * from them are cleared until no seeds are left.
+ * Inputs:
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * Frontier_T seeds: an empty stack used to store the seeds
+ * Return: none
+ * Expects
+ * - bitmap and seeds to be non-null
+************************/
+void spanClearEdges(Bit2_T bitmap, Frontier_T seeds) {
+        assert(bitmap != NULL && seeds != NULL);
+
+        int width = Bit2_width(bitmap);
+        int height = Bit2_height(bitmap);
+
+        /* seeding from the edges of the bitmap */
+        spanSeedRuns(Bit2_row(bitmap, 0), 0, width - 1, 0, seeds);
+        spanSeedRuns(Bit2_row(bitmap, height - 1), 0, width - 1, height - 1,
+                     seeds);
+        for (int row = 1; row < height - 1; row++) {
+                if (Bit2_get(bitmap, 0, row) == 1) {
+                        Frontier_push(seeds, 0, row);
+                }
+                if (Bit2_get(bitmap, width - 1, row) == 1) {
+                        Frontier_push(seeds, width - 1, row);
+                }
+        }
+
+        spanFill(bitmap, seeds);
+}
+
+/**********spanFill********
+ * About: This function clears the black run of every seed and every run
+ * connected to it, pushing the runs overlapping a cleared run in the rows
+ * above and below as new seeds until no seeds are left. Seeds on bits that
+ * are already white are skipped.
+ * Inputs:
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * Frontier_T seeds: the stack holding the seeds, empty when it returns
+ * Return: none
+ * Expects
+ * - bitmap and seeds to be non-null and every seed to be inside bitmap
+************************/
+void spanFill(Bit2_T bitmap, Frontier_T seeds) {
+        assert(bitmap != NULL && seeds != NULL);
+
+        int height = Bit2_height(bitmap);
+        int words = Bit2_row_words(bitmap);
+
+        /* clearing runs until there is nothing left to fill */
+        int col, row;
+        while (Frontier_pop(seeds, &col, &row)) {
+                /* the run may have already been cleared by another seed */
+                Bit2_word *span = Bit2_row_mut(bitmap, row);
+                if (((span[col / BIT2_WORD_BITS] >> (col % BIT2_WORD_BITS)) &
+                     1) == 0) {
+                        continue;
+                }
+                int first = spanRunStart(span, col);
+                int last = spanRunEnd(span, col, words);
+                spanClearRange(span, first, last);
+
+                if (row > 0) {
+                        spanSeedRuns(Bit2_row(bitmap, row - 1), first, last,
+                                     row - 1, seeds);
+                }
+                if (row < height - 1) {
+                        spanSeedRuns(Bit2_row(bitmap, row + 1), first, last,
+                                     row + 1, seeds);
+                }
+        }
+}
+
+/**********spanRunStart********
+ * About: This function finds the first column of the black run that holds
+ * the given column, skipping whole black words at a time.
+ * Inputs:
+ * const Bit2_word *span: the words of the row
+ * int col: column index of a black bit in the row
+ * Return: the column index of the leftmost bit of the run
+************************/
+int spanRunStart(const Bit2_word *span, int col) {
+        int w = col / BIT2_WORD_BITS;
+        Bit2_word white = ~span[w] & ~BITS_FROM(col % BIT2_WORD_BITS);
+
+        while (white == 0) {
+                if (w == 0) {
+                        return 0;
+                }
+                w--;
+                white = ~span[w];
+        }
+        return w * BIT2_WORD_BITS + BIT2_WORD_BITS - __builtin_clzll(white);
+}
+
+/**********spanRunEnd********
+ * About: This function finds the last column of the black run that holds
+ * the given column, skipping whole black words at a time. Padding bits are
+ * always white, so a run never goes past the width of the row.
+ * Inputs:
+ * const Bit2_word *span: the words of the row
+ * int col: column index of a black bit in the row
+ * int words: number of words in the row
+ * Return: the column index of the rightmost bit of the run
+************************/
+int spanRunEnd(const Bit2_word *span, int col, int words) {
+        int w = col / BIT2_WORD_BITS;
+        int b = col % BIT2_WORD_BITS;
+        Bit2_word white = b == BIT2_WORD_BITS - 1 ? 0 :
+                          ~span[w] & BITS_FROM(b + 1);
+
+        while (white == 0) {
+                w++;
+                if (w == words) {
+                        return words * BIT2_WORD_BITS - 1;
+                }
+                white = ~span[w];
+        }
+        return w * BIT2_WORD_BITS + __builtin_ctzll(white) - 1;
+}
+
+/**********spanNextBlack********
+ * About: This function finds the first black bit of a row at or after the
+ * given column, skipping whole white words at a time.
+ * Inputs:
+ * const Bit2_word *span: the words of the row
+ * int col: column index to start looking from, at least 0
+ * int words: number of words in the row
+ * Return: the column index of the black bit, or -1 if there is none
+************************/
+int spanNextBlack(const Bit2_word *span, int col, int words) {
+        int w = col / BIT2_WORD_BITS;
+        if (w >= words) {
+                return -1;
+        }
+        Bit2_word black = span[w] & BITS_FROM(col % BIT2_WORD_BITS);
+
+        while (black == 0) {
+                w++;
+                if (w == words) {
+                        return -1;
+                }
+                black = span[w];
+        }
+        return w * BIT2_WORD_BITS + __builtin_ctzll(black);
+}
+
+/**********spanClearRange********
+ * About: This function makes the bits from column first to column last
+ * (both included) white, a word at a time.
+ * Inputs:
+ * Bit2_word *span: the words of the row
+ * int first: the first column to clear
+ * int last: the last column to clear
+ * Return: none
+************************/
+void spanClearRange(Bit2_word *span, int first, int last) {
+        int firstWord = first / BIT2_WORD_BITS;
+        int lastWord = last / BIT2_WORD_BITS;
+
+        for (int w = firstWord; w <= lastWord; w++) {
+                Bit2_word mask = ~(Bit2_word)0;
+                if (w == firstWord) {
+                        mask &= BITS_FROM(first % BIT2_WORD_BITS);
+                }
+                if (w == lastWord && last % BIT2_WORD_BITS !=
+                    BIT2_WORD_BITS - 1) {
+                        mask &= ~BITS_FROM(last % BIT2_WORD_BITS + 1);
+                }
+                span[w] &= ~mask;
+        }
+}
+
+/**********spanSeedRuns********
+ * About: This function pushes one seed for every black run of a row that
+ * has a bit between column first and column last (both included). The
+ * starts of the runs are found with shifts on whole words.
+ * Inputs:
+ * const Bit2_word *span: the words of the row
+ * int first: the first column to look at
+ * int last: the last column to look at
+ * int row: row index of the row, stored with the seeds
+ * Frontier_T seeds: the seed stack
+ * Return: none
+************************/
+void spanSeedRuns(const Bit2_word *span, int first, int last, int row,
+                  Frontier_T seeds) {
+        int firstWord = first / BIT2_WORD_BITS;
+        int lastWord = last / BIT2_WORD_BITS;
+        Bit2_word carry = 0;
+
+        for (int w = firstWord; w <= lastWord; w++) {
+                Bit2_word black = span[w];
+                if (w == firstWord) {
+                        black &= BITS_FROM(first % BIT2_WORD_BITS);
+                }
+                if (w == lastWord && last % BIT2_WORD_BITS !=
+                    BIT2_WORD_BITS - 1) {
+                        black &= ~BITS_FROM(last % BIT2_WORD_BITS + 1);
+                }
+
+                /* a run starts at a black bit whose left neighbour is white */
+                Bit2_word starts = black & ~((black << 1) | carry);
+                carry = black >> (BIT2_WORD_BITS - 1);
+
+                while (starts != 0) {
+                        Frontier_push(seeds, w * BIT2_WORD_BITS +
+                                 __builtin_ctzll(starts), row);
+                        starts &= starts - 1;
+                }
+        }
+}
+
+#undef BITS_FROM
@@ -0,0 +1,30 @@
+/*
+ *     spanFill.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds a scanline flood fill that clears the black
+ *     edges of a Bit2_T bitmap. Instead of visiting one bit at a time, it
+ *     clears a whole horizontal run of black bits at once and only seeds the
+ *     runs that touch it in the rows above and below.
+ *
+ */
+
+#ifndef SPANFILL_INCLUDED
+#define SPANFILL_INCLUDED
+
+#include <bit2.h>
+#include <frontier.h>
+
+extern void spanClearEdges(Bit2_T bitmap, Frontier_T seeds);
+extern void spanFill(Bit2_T bitmap, Frontier_T seeds);
+
+/* helpers on the words of a single row, shared with the other engines */
+extern int spanRunStart(const Bit2_word *span, int col);
+extern int spanRunEnd(const Bit2_word *span, int col, int words);
+extern int spanNextBlack(const Bit2_word *span, int col, int words);
+extern void spanClearRange(Bit2_word *span, int first, int last);
+extern void spanSeedRuns(const Bit2_word *span, int first, int last, int row,
+                         Frontier_T seeds);
+
+#endif
@@ -0,0 +1,472 @@
+/*
+ *     streamClear.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file clears the black edges of a pbm file while streaming
+ *     it. Each row that is read is kept in a queue together with its black
+ *     runs, and every run gets a label that is joined in a union-find forest
+ *     with the runs it touches in the row above. A component is marked when
+ *     one of its runs is on an edge, and it is finished once the last row
+ *     read has none of its runs. The oldest queued rows are printed as long
+ *     as each of their runs is marked (and cleared) or finished. Only the
+ *     labels of the runs of queued rows and of the last row are still
+ *     needed, so whenever the queue runs empty, and whenever the forest
+ *     fills up with labels of rows that were printed, those labels are
+ *     renumbered from 0 and the forest starts over. The forest is therefore
+ *     bounded by the runs of the waiting rows. The waiting rows themselves
+ *     are not bounded: a component that neither reaches an edge nor ends
+ *     holds every row from its first one, up to the whole image. The caller
+ *     gives the most rows that may be held, and streaming stops with an
+ *     error when more are needed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <mem.h>
+#include <bit2.h>
+#include <pbmReadWrite.h>
+#include <spanFill.h>
+#include <runLabel.h>
+#include <streamClear.h>
+
+/**********struct StreamRuns********
+ * About: This struct holds the black runs of one row, from left to right,
+ *        with the label of each run.
+************************/
+typedef struct StreamRuns {
+        int length; /* number of runs */
+        int capacity; /* number of runs that fit before growing */
+        int *first; /* first column of each run */
+        int *last; /* last column of each run */
+        int *label; /* label of each run in the forest */
+} StreamRuns;
+
+/**********struct StreamRow********
+ * About: This struct holds a row that is waiting to be printed.
+************************/
+typedef struct StreamRow {
+        Bit2_word *words; /* the bits of the row */
+        StreamRuns runs; /* the black runs of the row */
+} StreamRow;
+
+/**********struct Stream********
+ * About: This struct holds everything that is kept between rows.
+************************/
+typedef struct Stream {
+        int width; /* number of cols in the image */
+        int height; /* number of rows in the image */
+        int words; /* number of words in a row */
+        FILE *outputfp; /* where the rows are printed */
+        int format; /* PBM_PLAIN or PBM_RAW output */
+        unsigned char *bytes; /* buffer for reading raw rows and printing */
+        StreamRow *queue; /* ring of rows waiting to be printed */
+        int slots; /* number of rows that fit in the ring */
+        int head; /* slot of the oldest waiting row */
+        int count; /* number of waiting rows */
+        int peak; /* largest number of rows that were waiting */
+        StreamRuns previous; /* the runs of the last row that was read */
+        int maxRows; /* most rows that may wait, or 0 for no limit */
+        int labels; /* number of labels in the forest */
+        int labelCapacity; /* number of labels that fit before growing */
+        long *parent; /* union-find parent of each label */
+        unsigned char *onEdge; /* for roots, 1 if the component is marked */
+        int *seen; /* for roots, the last row that had a run of it */
+        unsigned char *scratch; /* the roots kept while renumbering */
+} Stream;
+
+/* function declarations */
+void streamInitRuns(StreamRuns *runs);
+void streamAddRun(StreamRuns *runs, int first, int last, int label);
+int streamNewLabel(Stream *stream, bool edge);
+void streamUnion(Stream *stream, int label1, int label2);
+StreamRow *streamPushRow(Stream *stream);
+void streamLabelRow(Stream *stream, StreamRow *current, int row);
+void streamPrintReady(Stream *stream, int row);
+int streamLiveRuns(Stream *stream);
+void streamRenumber(Stream *stream);
+void streamFree(Stream *stream);
+
+/**********streamClearEdges********
+ * About: This function reads the rows of a pbm file after its header, clears
+ * every black bit that is connected to an edge, and prints the cleaned
+ * file as the rows become final.
+ * Inputs:
+ * FILE *inputfp: a pointer to a file positioned after the header
+ * const PbmHeader *header: the header read from the file
+ * FILE *outputfp: a pointer to the file the cleaned image is printed to
+ * int format: PBM_PLAIN or PBM_RAW output
+ * int maxRows: the most rows that may be held at the same time, at least
+ *              1, or 0 (or less) for no limit
+ * Return: the largest number of rows that had to be held at the same time,
+ *         or -1 if more than maxRows had to be held, in which case only the
+ *         header and the rows before the oldest held one were printed
+ * Expects
+ * - inputfp, header and outputfp to be non-null
+ * - the file to hold header->height valid rows, otherwise the program exits
+ *   through pbmBadFormat
+************************/
+int streamClearEdges(FILE *inputfp, const PbmHeader *header,
+                     FILE *outputfp, int format, int maxRows) {
+        assert(inputfp != NULL && header != NULL && outputfp != NULL);
+
+        Stream stream;
+        stream.width = header->width;
+        stream.height = header->height;
+        stream.words = (header->width + BIT2_WORD_BITS - 1) / BIT2_WORD_BITS;
+        stream.outputfp = outputfp;
+        stream.format = format;
+        stream.bytes = ALLOC(PBM_ROW_BUFFER(header->width));
+        stream.slots = 16;
+        stream.queue = CALLOC(stream.slots, (long)sizeof(StreamRow));
+        stream.head = 0;
+        stream.count = 0;
+        stream.peak = 0;
+        stream.maxRows = maxRows > 0 ? maxRows : 0;
+        streamInitRuns(&stream.previous);
+        stream.labels = 0;
+        stream.labelCapacity = 64;
+        stream.parent = ALLOC(stream.labelCapacity * (long)sizeof(long));
+        stream.onEdge = ALLOC(stream.labelCapacity);
+        stream.seen = ALLOC(stream.labelCapacity * (long)sizeof(int));
+        stream.scratch = ALLOC(stream.labelCapacity);
+
+        pbmWriteHeader(outputfp, format, header->width, header->height);
+
+        for (int row = 0; row < header->height; row++) {
+                StreamRow *current = streamPushRow(&stream);
+                if (current == NULL) {
+                        streamFree(&stream);
+                        return -1;
+                }
+                if (!pbmReadRow(inputfp, header->format, header->width,
+                                current->words, stream.bytes)) {
+                        pbmBadFormat(inputfp, NULL);
+                }
+                streamLabelRow(&stream, current, row);
+                streamPrintReady(&stream, row);
+                if (stream.count == 0) {
+                        streamRenumber(&stream);
+                }
+        }
+        /* every component is finished or marked after the last row */
+        assert(stream.count == 0);
+
+        streamFree(&stream);
+        return stream.peak;
+}
+
+/**********streamFree********
+ * About: This function frees the rows, runs and forest of a stream
+ * Inputs:
+ * Stream *stream: the stream state
+ * Return: none
+************************/
+void streamFree(Stream *stream) {
+        for (int slot = 0; slot < stream->slots; slot++) {
+                if (stream->queue[slot].words != NULL) {
+                        FREE(stream->queue[slot].words);
+                        FREE(stream->queue[slot].runs.first);
+                        FREE(stream->queue[slot].runs.last);
+                        FREE(stream->queue[slot].runs.label);
+                }
+        }
+        FREE(stream->queue);
+        FREE(stream->previous.first);
+        FREE(stream->previous.last);
+        FREE(stream->previous.label);
+        FREE(stream->parent);
+        FREE(stream->onEdge);
+        FREE(stream->seen);
+        FREE(stream->scratch);
+        FREE(stream->bytes);
+}
+
+/**********streamInitRuns********
+ * About: This function makes an empty list of runs
+ * Inputs:
+ * StreamRuns *runs: the list to initialize
+ * Return: none
+************************/
+void streamInitRuns(StreamRuns *runs) {
+        runs->length = 0;
+        runs->capacity = 16;
+        runs->first = ALLOC(runs->capacity * (long)sizeof(int));
+        runs->last = ALLOC(runs->capacity * (long)sizeof(int));
+        runs->label = ALLOC(runs->capacity * (long)sizeof(int));
+}
+
+/**********streamAddRun********
+ * About: This function adds a run to the end of a list, doubling the list
+ * when it is full
+ * Inputs:
+ * StreamRuns *runs: the list
+ * int first: first column of the run
+ * int last: last column of the run
+ * int label: label of the run
+ * Return: none
+************************/
+void streamAddRun(StreamRuns *runs, int first, int last, int label) {
+        if (runs->length == runs->capacity) {
+                runs->capacity *= 2;
+                long bytes = runs->capacity * (long)sizeof(int);
+                RESIZE(runs->first, bytes);
+                RESIZE(runs->last, bytes);
+                RESIZE(runs->label, bytes);
+        }
+        runs->first[runs->length] = first;
+        runs->last[runs->length] = last;
+        runs->label[runs->length] = label;
+        runs->length++;
+}
+
+/**********streamNewLabel********
+ * About: This function adds a label that is its own root to the forest.
+ * When the forest is full it is first renumbered, and the label arrays are
+ * only doubled if most of the labels are still held by runs.
+ * Inputs:
+ * Stream *stream: the stream state
+ * bool edge: true if the run of the label is on an edge
+ * Return: the new label
+************************/
+int streamNewLabel(Stream *stream, bool edge) {
+        if (stream->labels == stream->labelCapacity &&
+            streamLiveRuns(stream) <= stream->labelCapacity / 2) {
+                streamRenumber(stream);
+        }
+        if (stream->labels == stream->labelCapacity) {
+                stream->labelCapacity *= 2;
+                long count = stream->labelCapacity;
+                RESIZE(stream->parent, count * (long)sizeof(long));
+                RESIZE(stream->onEdge, count);
+                RESIZE(stream->seen, count * (long)sizeof(int));
+                RESIZE(stream->scratch, count);
+        }
+        int label = stream->labels++;
+        stream->parent[label] = label;
+        stream->onEdge[label] = edge;
+        stream->seen[label] = -1;
+        return label;
+}
+
+/**********streamUnion********
+ * About: This function joins the components of two labels, keeping the edge
+ * mark on the new root
+ * Inputs:
+ * Stream *stream: the stream state
+ * int label1: a label of the first component
+ * int label2: a label of the second component
+ * Return: none
+************************/
+void streamUnion(Stream *stream, int label1, int label2) {
+        int root1 = RunLabels_find(stream->parent, label1);
+        int root2 = RunLabels_find(stream->parent, label2);
+        if (root1 == root2) {
+                return;
+        }
+        RunLabels_union(stream->parent, root1, root2);
+        int root = root1 < root2 ? root1 : root2;
+        stream->onEdge[root] = stream->onEdge[root1] | stream->onEdge[root2];
+}
+
+/**********streamPushRow********
+ * About: This function returns the slot after the newest waiting row,
+ * doubling the ring when every slot is taken
+ * Inputs:
+ * Stream *stream: the stream state
+ * Return: the slot for the next row, with an empty list of runs, or NULL
+ *         if maxRows rows are already waiting
+************************/
+StreamRow *streamPushRow(Stream *stream) {
+        if (stream->maxRows > 0 && stream->count == stream->maxRows) {
+                return NULL;
+        }
+        if (stream->count == stream->slots) {
+                StreamRow *queue = CALLOC(stream->slots * 2, 
+                                          (long)sizeof(StreamRow));
+                for (int i = 0; i < stream->count; i++) {
+                        queue[i] = stream->queue[(stream->head + i) %
+                                                 stream->slots];
+                }
+                FREE(stream->queue);
+                stream->queue = queue;
+                stream->head = 0;
+                stream->slots *= 2;
+        }
+
+        StreamRow *slot = &stream->queue[(stream->head + stream->count) %
+                                         stream->slots];
+        if (slot->words == NULL) {
+                slot->words = ALLOC(stream->words * (long)sizeof(Bit2_word));
+                streamInitRuns(&slot->runs);
+        }
+        slot->runs.length = 0;
+
+        stream->count++;
+        if (stream->count > stream->peak) {
+                stream->peak = stream->count;
+        }
+        return slot;
+}
+
+/**********streamLabelRow********
+ * About: This function finds the black runs of the row that was just read,
+ * gives each a new label, joins them with the runs of the previous row
+ * they touch, and records that their components are still open.
+ * Inputs:
+ * Stream *stream: the stream state
+ * StreamRow *current: the row that was just read
+ * int row: the index of the row in the image
+ * Return: none
+************************/
+void streamLabelRow(Stream *stream, StreamRow *current, int row) {
+        StreamRuns *runs = &current->runs;
+        StreamRuns *previous = &stream->previous;
+        bool edgeRow = row == 0 || row == stream->height - 1;
+
+        int col = spanNextBlack(current->words, 0, stream->words);
+        while (col != -1) {
+                int last = spanRunEnd(current->words, col, stream->words);
+                int label = streamNewLabel(stream, edgeRow || col == 0 ||
+                                           last == stream->width - 1);
+                streamAddRun(runs, col, last, label);
+                col = spanNextBlack(current->words, last + 1, stream->words);
+        }
+
+        /* joining with the runs above, walking both rows like a merge */
+        int a = 0;
+        int b = 0;
+        while (a < previous->length && b < runs->length) {
+                if (previous->first[a] <= runs->last[b] &&
+                    runs->first[b] <= previous->last[a]) {
+                        streamUnion(stream, previous->label[a], 
+                                    runs->label[b]);
+                }
+                if (previous->last[a] < runs->last[b]) {
+                        a++;
+                }
+                else {
+                        b++;
+                }
+        }
+
+        /* the components of this row are open, and it becomes previous */
+        previous->length = 0;
+        for (int i = 0; i < runs->length; i++) {
+                stream->seen[RunLabels_find(stream->parent, 
+                                            runs->label[i])] = row;
+                streamAddRun(previous, runs->first[i], runs->last[i],
+                             runs->label[i]);
+        }
+}
+
+/**********streamPrintReady********
+ * About: This function prints the oldest waiting rows for as long as all of
+ * their runs are final, clearing the runs of marked components first
+ * Inputs:
+ * Stream *stream: the stream state
+ * int row: the index of the row that was read last
+ * Return: none
+************************/
+void streamPrintReady(Stream *stream, int row) {
+        while (stream->count > 0) {
+                StreamRow *oldest = &stream->queue[stream->head];
+                StreamRuns *runs = &oldest->runs;
+
+                /* a run of an open, unmarked component is not final yet */
+                for (int i = 0; i < runs->length; i++) {
+                        int root = RunLabels_find(stream->parent,
+                                                  runs->label[i]);
+                        if (!stream->onEdge[root] && 
+                            stream->seen[root] == row) {
+                                return;
+                        }
+                }
+                for (int i = 0; i < runs->length; i++) {
+                        int root = RunLabels_find(stream->parent,
+                                                  runs->label[i]);
+                        if (stream->onEdge[root]) {
+                                spanClearRange(oldest->words, runs->first[i],
+                                               runs->last[i]);
+                        }
+                }
+                pbmWriteRow(stream->outputfp, stream->format, stream->width,
+                            oldest->words, stream->bytes);
+
+                stream->head = (stream->head + 1) % stream->slots;
+                stream->count--;
+        }
+}
+
+/**********streamLiveRuns********
+ * About: This function counts the runs that still hold a label: those of
+ * the waiting rows and of the last row that was read
+ * Inputs:
+ * Stream *stream: the stream state
+ * Return: the number of runs
+************************/
+int streamLiveRuns(Stream *stream) {
+        int runs = stream->previous.length;
+        for (int i = 0; i < stream->count; i++) {
+                runs += stream->queue[(stream->head + i) %
+                                      stream->slots].runs.length;
+        }
+        return runs;
+}
+
+/**********streamRenumber********
+ * About: This function starts the forest over. Only the runs of the waiting
+ * rows and of the last row still hold labels, so every root they lead to is
+ * given one of the labels 0, 1, ... in order, with its edge mark and the
+ * last row it was seen on kept, and the runs are pointed at their new
+ * labels.
+ * Inputs:
+ * Stream *stream: the stream state
+ * Return: none
+************************/
+void streamRenumber(Stream *stream) {
+        int lists = stream->count + 1;
+        for (int label = 0; label < stream->labels; label++) {
+                stream->scratch[label] = 0;
+        }
+
+        /* pointing every run at its root, and marking the roots kept */
+        for (int l = 0; l < lists; l++) {
+                StreamRuns *runs = l == stream->count ? &stream->previous :
+                        &stream->queue[(stream->head + l) %
+                                       stream->slots].runs;
+                for (int i = 0; i < runs->length; i++) {
+                        runs->label[i] = RunLabels_find(stream->parent,
+                                                        runs->label[i]);
+                        stream->scratch[runs->label[i]] = 1;
+                }
+        }
+
+        /* 
+         * the new label of a root is never above the old one, so the roots
+         * can be moved down in place; parent holds the new label of each
+         */
+        int labels = 0;
+        for (int label = 0; label < stream->labels; label++) {
+                if (stream->scratch[label]) {
+                        stream->onEdge[labels] = stream->onEdge[label];
+                        stream->seen[labels] = stream->seen[label];
+                        stream->parent[label] = labels;
+                        labels++;
+                }
+        }
+        for (int l = 0; l < lists; l++) {
+                StreamRuns *runs = l == stream->count ? &stream->previous :
+                        &stream->queue[(stream->head + l) %
+                                       stream->slots].runs;
+                for (int i = 0; i < runs->length; i++) {
+                        runs->label[i] = stream->parent[runs->label[i]];
+                }
+        }
+        for (int label = 0; label < labels; label++) {
+                stream->parent[label] = label;
+        }
+        stream->labels = labels;
+}
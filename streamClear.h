@@ -0,0 +1,26 @@
+/*
+ *     streamClear.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds a streaming edge clearing engine for pbm files
+ *     that are too large to hold in memory. Rows are read one at a time,
+ *     and every row is printed as soon as all of its black runs are known to
+ *     either reach an edge (and are cleared) or to belong to a finished
+ *     component that does not (and are kept). A row has to be held until
+ *     then, so an image with a tall component that does neither can need
+ *     most of its rows held; the caller bounds how many may be, and gets an
+ *     error instead of the rest of the image when that is not enough.
+ *
+ */
+
+#ifndef STREAMCLEAR_INCLUDED
+#define STREAMCLEAR_INCLUDED
+
+#include <stdio.h>
+#include <pbmReadWrite.h>
+
+extern int streamClearEdges(FILE *inputfp, const PbmHeader *header,
+                            FILE *outputfp, int format, int maxRows);
+
+#endif
@@ -3,11 +3,12 @@
  *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
  *     HW2: iii
  *
- *     About: Given a pgm file that represents a solved sudoku problem with 9 
- *     by 9 dimension and 9 as the max value, this program checks if the given 
- *     solution is valid. The program checks to see if each value in the same 
- *     row, same column, or same 3-by-3 subsudoku are unique, and exits with 
- *     success if the solution is valid.
+ *     About: Given a pgm file that represents a solved sudoku problem with N*N
+ *     by N*N dimension and N*N as the max value (9 by 9 for the classic
+ *     sudoku, up to 64 by 64), this program checks if the given solution is
+ *     valid. The program checks to see if each value in the same row, same
+ *     column, or same N-by-N subsudoku are unique, and exits with success if
+ *     the solution is valid.
  */
 
 #include <uarray2.h>
@@ -20,30 +21,71 @@
 #include <mem.h>
 #include <pnmrdr.h>
 #include <except.h>
+#include <sudokuCheck.h>
+#include <sudokuBatch.h>
 
 /* function declarations */
 UArray2_T pgmHandler(FILE *fp);
-void arrayFiller(int col, int row, UArray2_T array, void *p1, void *p2);
-void zeroChecker(int col, int row, UArray2_T array, void *p1, void *p2);
-bool checkSubmaps(UArray2_T array);
-bool checkSubmapsHelper(UArray2_T array, int col, int row);
-bool checkRow(UArray2_T array);
-bool checkCol(UArray2_T array);
+void arrayFiller(int row, void *elems, int length, UArray2_T array, void *p1);
 
 
 /**********main********
  *
  * About: Opens the file or accepts information from stdin, calls pgmHandler
- *        to store sudoku values in a 2D array, calls checker functions to see
+ *        to store sudoku values in a 2D array, calls sudokuCheckGrid to see
  *        if the values fit to the sudoku rules, and depending on the result,
- *        exits with failure or success
+ *        exits with failure or success. With the -b option any number of
+ *        files and directories of pgm boards (stdin if none) are checked in
+ *        one run by sudokuBatch, printing one result per board; -p reads
+ *        packed 81 byte boards instead and -t sets the number of threads.
  * Inputs:
  * int argc: number of given arguments to start the program
  * char *argv: an array that stores the arguments
- * Return: EXIT_SUCCESS if the sudoku is valid, EXIT_FAILURE otherwise
- * Expects: argc to be 1 or 2, which is checked by openOrDie
+ * Return: EXIT_SUCCESS if the sudoku (every sudoku in batch mode) is
+ *         valid, EXIT_FAILURE otherwise
+ * Expects: argc to be 1 or 2 after the options unless -b is given, which is
+ *          checked by openOrDie
  ************************/
 int main(int argc, char *argv[]) {
+        bool batch = false;
+        bool packed = false;
+        int threads = 0;
+
+        /* handling the options given in front of the file names */
+        while (argc > 1 && argv[1][0] == '-' && argv[1][1] != '\0') {
+                if (strcmp(argv[1], "-b") == 0) {
+                        batch = true;
+                }
+                else if (strcmp(argv[1], "-p") == 0) {
+                        batch = true;
+                        packed = true;
+                }
+                else if (strcmp(argv[1], "-t") == 0 && argc > 2 &&
+                         atoi(argv[2]) > 0) {
+                        threads = atoi(argv[2]);
+                        /* dropping the option, then its count below */
+                        argv[1] = argv[0];
+                        argv++;
+                        argc--;
+                }
+                else {
+                        fprintf(stderr, "usage: %s [file]\n"
+                                "       %s -b [-p] [-t threads] "
+                                "[file|directory ...]\n", argv[0], argv[0]);
+                        return EXIT_FAILURE;
+                }
+                /* dropping the option so only the file names are left */
+                argv[1] = argv[0];
+                argv++;
+                argc--;
+        }
+
+        if (batch) {
+                bool allValid = sudokuBatch(argc - 1, argv + 1, packed,
+                                            threads, stdout);
+                return allValid ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
         /* trying to open the file correctly */
         FILE *fp = openOrDie(argc, argv);
 
@@ -51,8 +93,7 @@ int main(int argc, char *argv[]) {
         UArray2_T sudokuArray = pgmHandler(fp);
 
         /* checking if the input matches with the sudoku rules */
-        bool result = checkRow(sudokuArray) && checkCol(sudokuArray) &&
-                      checkSubmaps(sudokuArray);
+        bool result = sudokuCheckGrid(sudokuArray);
         
         /* free the 2D array and close the input stream */
         UArray2_free(&sudokuArray);
@@ -67,21 +108,19 @@ int main(int argc, char *argv[]) {
 
 /**********pgmHandler********
  * About: This function reads information from a pgm file given a file pointer.
- *        It checks if the file is in pgm format, with 9 by 9 dimensions and
- *        9 as the max value, as the file is supposed to represent a solved
- *        sudoku problem. Then it reads and inserts the values from the file to
- *        a 2D UArray, and finally checks that the none of the values are 0.
+ *        It checks if the file is in pgm format, with N*N by N*N dimensions
+ *        and N*N as the max value for N from 1 to SUDOKU_MAX_BOX, as the file
+ *        is supposed to represent a solved sudoku problem. Then it reads and
+ *        inserts the values from the file to a 2D UArray of bytes.
  * Inputs:
  * FILE *fp: a pointer to a file to read information from
  * Return: a UArray2_T structure that holds the values from the solved sudoku
  *         problem
  * Expects
- * - The file to be in Pnmrdr interface readable pgm format with 9 by 9 
- * dimensions and 9 as the max value
- * - The file to not contain any pixels with 0 intensity value
+ * - The file to be in Pnmrdr interface readable pgm format with N*N by N*N
+ * dimensions and N*N as the max value
 ************************/
 UArray2_T pgmHandler(FILE *fp) {
-        Except_T Pnmrdr_Badformat; /* checks if input is a pnm and is 9x9 */
         Pnmrdr_T image;
          /* should raise a runtime error when badformat */
         image = Pnmrdr_new(fp);
@@ -96,225 +135,48 @@ UArray2_T pgmHandler(FILE *fp) {
         // END_TRY;
 
         Pnmrdr_mapdata iMap = Pnmrdr_data(image);
-        if (iMap.type != 2 || iMap.width != 9 || iMap.height != 9 
-            || iMap.denominator != 9) {
+        if (iMap.type != 2 || iMap.width != iMap.height
+            || iMap.denominator != iMap.width
+            || sudokuBoxSize((int)iMap.width) == 0) {
                 Pnmrdr_free(&image);
                 fclose(fp);
                 exit(EXIT_FAILURE);
-        } /* initialize, fill a UArray2_T & check that sudoku values are > 0 */
-        UArray2_T sudoku = UArray2_new(iMap.width, iMap.height, sizeof(long));
-        UArray2_map_row_major(sudoku, arrayFiller, image);
-        bool zeroExists = false;
-        UArray2_map_row_major(sudoku, zeroChecker, &zeroExists);
-        if (zeroExists) {
-                UArray2_free(&sudoku);
-                Pnmrdr_free(&image);
-                fclose(fp);
-                exit(EXIT_FAILURE);
-        }
+        } /* initialize & fill a UArray2_T; zeros are caught by the checker */
+        UArray2_T sudoku = UArray2_new(iMap.width, iMap.height,
+                                       sizeof(unsigned char));
+        UArray2_map_rows(sudoku, arrayFiller, image);
         Pnmrdr_free(&image);
         return sudoku;
 }
 
 /**********arrayFiller********
  * About: This function is written to be used as the apply function of 
- *        UArray2_map_row_major, and fills the index being visited with the 
- *        value obtained from p2
- * int col: the column value of the cell that is going to be filled
- * int row: the row value of the cell that is going to be filled
- * UArray2_T array: array that is being traversed by the UArray2_map_row_major
- * void *p1: pointer to an current element visited   
- * void *p2: pointer to a Pnmrdr_T object
- * Return: none
- * Expects
- * - p1 and p2 to be non-null, which is handled by UArray_at and pgmHandler
- * respectively
-************************/
-void arrayFiller(int col, int row, UArray2_T array, void *p1, void *p2) {
-        (void) col;
-        (void) row;
-        (void) array;
-
-        /* get the next value in the pgm file */
-        unsigned num = Pnmrdr_get(p2);
-
-        /* update p1 pointer so it points to the value extracted from p2 */
-        long *arrayElt = p1;
-        *arrayElt = num;
-}
-
-/**********zeroChecker********
- * About: This function is written to be used as the apply function of 
- *        UArray2_map_row_major, and checks the UArray2 data structure to see 
- *        if there is any 0 value.
+ *        UArray2_map_rows, and fills every element of the row being visited
+ *        with the next values obtained from p1. A value above the maxval,
+ *        which is the width of the array, makes the program exit with
+ *        failure before it is narrowed to a byte.
  * Inputs:
- * int col: the column value of the cell that is going to be checked
- * int row: the row value of the cell that is going to be checked
- * UArray2_T array: array that is being traversed by the UArray2_map_row_major
- * void *p1: pointer to an current element visited   
- * void *p2: pointer to a boolean keeping track whether a zero value was seen
+ * int row: the row value of the cells that are going to be filled
+ * void *elems: pointer to the first element of the row
+ * int length: the number of elements in the row
+ * UArray2_T array: array that is being traversed by the UArray2_map_rows
+ * void *p1: pointer to a Pnmrdr_T object
  * Return: none
  * Expects
- * - p1 and p2 pointers to be non-null, which is handled by UArray_at and 
+ * - elems and p1 to be non-null, which is handled by UArray2_map_rows and
  * pgmHandler respectively
 ************************/
-void zeroChecker(int col, int row, UArray2_T array, void *p1, void *p2) {
-        (void) col;
+void arrayFiller(int row, void *elems, int length, UArray2_T array, void *p1) {
         (void) row;
-        (void) array;
-        
-        long *arrayElt = p1;
-        bool *zeroExists = p2;
-
-        /* check if the current element being visited is zero */
-        if (*arrayElt == 0) {
-                *zeroExists = true;
-        }
-}
-
-/**********checkSubmaps********
- * About: This function checks if each 3x3 sub sudokus is valid with the help
- *        of checkSubmapsHelper function
- * Inputs:
- * UArray2_T array: array that where the data is stored
- * Return: return true if the submap is valid, false otherwise
-************************/
-bool checkSubmaps(UArray2_T array) {
-        
-        /* loops the middle element in each submap and sends those indices
-         * to  checkSubmapsHelper */
-        for (int i = 1; i < UArray2_height(array); i += 3) {
-                for (int j = 1; j < UArray2_width(array); j += 3) {
-                        if (!checkSubmapsHelper(array, j, i)) {
-                                return false;
-                        }
-                }
-        }
-
-        return true;
-}
-
-/**********checkSubmapsHelper********
- * About: Given a index (the middle element of the sub-sudoku), this function
- *        checks if the 3x3 sub-sudoku is valid
- * Inputs:
- * int col: the column value of the middle cell of the submap
- * int row: the row value of the middle cell of the submap
- * UArray2_T array: array that where the data is stored
- * Return: return true if the submap is valid, false otherwise
-  * Expects
- * - char subArray to be non-null
-************************/
-bool checkSubmapsHelper(UArray2_T array, int col, int row) {
-
-        /* initializing a char array with the size of submap element size */
-        char *subArray = (char*)malloc(sizeof(char) * 9);
-        assert(subArray != NULL);  
-        /* filling the char array with 'a's */
-        for (unsigned int i = 0; i < sizeof(subArray); i++) {
-                subArray[i] = 'a';
-        }  
-        /* checking if the number in the submap is from 0 to 9, changing
-         * char array value to 'f' */
-        for (int i = row - 1; i <= row + 1; i++) {
-                for (int j = col - 1; j <= col + 1; j++) {
-                        int *num = UArray2_at(array, j, i);
-                        subArray[*num - 1] = 'f';
-                }
-        }
-        /* if there is any 'a' left in the char array, it means that the
-        * submap doesn't have all values from 0 to 9 */
-        for (unsigned int k = 0; k < sizeof(subArray); k++) {
-                if (subArray[k] == 'a') {
-                        free(subArray);
-                        return false;
-                }
-        }
-        free(subArray);
-        return true;
-}
-
-/**********checkRow********
- * About: This function is used to check that there are no two same intensity 
- *        values on the same row.
- * Inputs: 
- * UArray2_T array: 2D data structure to check the rows from 
- * Return: a boolean variable indicating whether each value on the same row is
- *         unique
- * Expects
- * - rowArray to be non-null
-************************/
-bool checkRow(UArray2_T array) {
-        /* create a char array to keep track of values on the same row */
-        char *rowArray = (char*)malloc(sizeof(char) * 9);
-        assert(rowArray != NULL);
-        /* make all values on char array 'a' to indicate unseen */
-        for (unsigned int i = 0; i < sizeof(rowArray); i++) {
-                rowArray[i] = 'a';
-        }
-        /* traverse a row of the array and keep track of unique values */
-        for (int i = 0; i < UArray2_height(array); i++) {
-                for (int j = 0; j < UArray2_width(array); j++) {
-                        int *num = UArray2_at(array, j, i);
-                        rowArray[*num - 1] = 'f';
-                }
-                /* see if there are any unseen values from 1-9 */
-                for (unsigned int k = 0; k < sizeof(rowArray); k++) {
-                        /* if yes, there needs to be non-unique intensity */
-                        if (rowArray[k] == 'a') {
-                                free(rowArray);
-                                return false;
-                        }
-                }
-                /* set values of rowArray back to unseen */
-                for (unsigned int l = 0; l < sizeof(rowArray); l++) {
-                        rowArray[l] = 'a';
-                }
-        }
-        free(rowArray);
-        return true;
-}
 
-/**********checkCol********
- * About: This function is used to check that there are no two same intensity 
- *        values on the same column.
- * Inputs:
- * UArray2_T array: 2D data structure to check the columns from
- * Return: a boolean variable indicating whether each value on the same column
- *         is unique
- * Expects
- * - colArray to be non-null
-************************/
-bool checkCol(UArray2_T array) {
-        /* create a char array to keep track of values on the same column */
-        char *colArray = (char*)malloc(sizeof(char) * 9);
-        assert(colArray != NULL);
-        /* make all values on char array 'a' to indicate unseen */
-        for (unsigned int i = 0; i < sizeof(colArray); i++) {
-                colArray[i] = 'a';
-        }
-        /* traverse a column of the array and keep track of unique values */
-        for (int j = 0; j < UArray2_width(array); j++) {
-                for (int i = 0; i < UArray2_height(array); i++) {
-                        int *num = UArray2_at(array, j, i);
-                        colArray[*num - 1] = 'f';
-                }
-                /* see if there are any unseen values from 1-9 */
-                for (unsigned int k = 0; k < sizeof(colArray); k++) {
-                        /* if yes, there needs to be non-unique intensity */
-                        if (colArray[k] == 'a') {
-                                free(colArray);
-                                return false;
-                        }
-                }
-                /* set values of rowArray back to unseen */
-                for (unsigned int l = 0; l < sizeof(colArray); l++) {
-                        colArray[l] = 'a';
+        /* get the next values in the pgm file and store them in the row */
+        unsigned maxval = (unsigned)UArray2_width(array);
+        unsigned char *rowElts = elems;
+        for (int col = 0; col < length; col++) {
+                unsigned value = Pnmrdr_get(p1);
+                if (value > maxval) {
+                        exit(EXIT_FAILURE);
                 }
+                rowElts[col] = (unsigned char)value;
         }
-        free(colArray);
-        return true;
 }
-
-
-
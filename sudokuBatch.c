@@ -0,0 +1,580 @@
+/*
+ *     sudokuBatch.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file validates many solved sudokus in one run. Every input
+ *     name is either a directory, whose regular files are read in name
+ *     order, or a file ("-" for stdin). A file holds one or more pgm boards
+ *     (plain P2 or raw P5) one after another, each N * N by N * N with maxval
+ *     N * N for N from 1 to 8, or, in packed mode, 9 by 9 boards of 81 bytes
+ *     each holding the values 1 to 9 in row major order. Boards are read
+ *     into one of two fixed buffers of at most BATCH_BOARDS boards; a full
+ *     buffer is split between the threads and checked with sudokuCheckBoard
+ *     while the other one is filled, so the memory used does not grow with
+ *     the number of boards. A board that cannot be read is reported as
+ *     malformed; since a pgm stream cannot be resynchronised after a bad
+ *     board, the rest of that file is skipped.
+ */
+
+/* clock_gettime, getc_unlocked, opendir and stat are POSIX, not c99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <mem.h>
+#include <sudokuCheck.h>
+#include <sudokuBatch.h>
+
+/* the most boards, and bytes of their values, held by one buffer */
+#define BATCH_BOARDS 4096
+#define BATCH_CELLS (BATCH_BOARDS * SUDOKU_CELLS)
+
+/* the result of a board; boards are unchecked until a worker checks them */
+typedef enum {
+        BOARD_VALID, BOARD_INVALID, BOARD_MALFORMED, BOARD_UNCHECKED
+} BoardResult;
+
+/**********struct Board********
+ * About: This struct holds one board and where it was read from
+************************/
+typedef struct Board {
+        unsigned char *cells; /* the values of the board, row major */
+        int box; /* the side of a box of the board, 0 if it was not read */
+        int source; /* index of the file in the list of sources */
+        int index; /* index of the board in its file, from 0 */
+        BoardResult result; /* filled in by the workers */
+} Board;
+
+/**********struct BatchJob********
+ * About: This struct holds the boards checked by one thread
+************************/
+typedef struct BatchJob {
+        Board *boards; /* the first board of the thread */
+        int length; /* the number of boards of the thread */
+        bool started; /* true while a thread, to be joined, checks them */
+} BatchJob;
+
+/**********struct BatchBuffer********
+ * About: This struct holds up to BATCH_BOARDS boards, and the threads
+ *        checking them once the buffer is handed off
+************************/
+typedef struct BatchBuffer {
+        Board *boards; /* the boards in input order */
+        int length; /* the number of boards */
+        unsigned char *cells; /* the values of every board, BATCH_CELLS */
+        long cellsLength; /* the number of bytes used in cells */
+        BatchJob *jobs; /* one job per thread */
+        pthread_t *workers; /* the threads of the started jobs */
+} BatchBuffer;
+
+/**********struct Batch********
+ * About: This struct holds the two buffers of a run, the names of the
+ *        files the boards came from and the results reported so far
+************************/
+typedef struct Batch {
+        BatchBuffer buffers[2]; /* one being filled, one being checked */
+        int current; /* the index of the buffer being filled */
+        int threads; /* the number of jobs of each buffer */
+        char **sources; /* the names of the files, owned by the batch */
+        int sourceCount; /* the number of names in sources */
+        int sourceCapacity; /* the number of names that fit in sources */
+        bool packed; /* true for packed board files */
+        FILE *out; /* where the results are printed */
+        long totals[3]; /* the number of boards reported per result */
+} Batch;
+
+/* function declarations */
+void batchHandOff(Batch *batch);
+void batchStart(Batch *batch, BatchBuffer *buffer);
+void batchFinish(Batch *batch, BatchBuffer *buffer);
+void batchReadName(Batch *batch, const char *name);
+void batchReadDirectory(Batch *batch, const char *name);
+void batchReadFile(Batch *batch, const char *name);
+int batchAddSource(Batch *batch, const char *name);
+Board *batchAddBoard(Batch *batch, int source, int index, int side);
+bool batchReadPgmHeader(FILE *fp, int *format, int *side, bool *ended);
+bool batchReadPgmCells(FILE *fp, int format, unsigned char *cells, int side);
+int batchSkipSpace(FILE *fp);
+bool batchReadNumber(FILE *fp, int *value);
+int batchCompareNames(const void *a, const void *b);
+void *batchWorker(void *cl);
+double batchNow(void);
+
+/**********sudokuBatch********
+ * About: This function reads every board from the given names, checks them
+ *        with the given number of threads, prints one line per board to out
+ *        ("name:index valid", "invalid" or "malformed") and a summary with
+ *        the number of boards checked per second to stderr
+ * Inputs:
+ * int count: the number of names
+ * char *names[]: the files and directories to read, stdin if count is 0
+ * bool packed: true if the files hold packed 81 byte boards
+ * int threads: the number of threads, 0 (or less) for one per online
+ *              processor
+ * FILE *out: where the results are printed
+ * Return: true if every board was read and is valid, false otherwise
+ * Expects
+ * - names to be non-null if count is positive, and out to be non-null
+************************/
+bool sudokuBatch(int count, char *names[], bool packed, int threads,
+                 FILE *out) {
+        assert(out != NULL && (count == 0 || names != NULL));
+
+        Batch batch;
+        memset(&batch, 0, sizeof(batch));
+        batch.packed = packed;
+        batch.out = out;
+        if (threads <= 0) {
+                threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        batch.threads = threads < 1 ? 1 : threads;
+        for (int b = 0; b < 2; b++) {
+                BatchBuffer *buffer = &batch.buffers[b];
+                buffer->boards = ALLOC(BATCH_BOARDS * sizeof(Board));
+                buffer->cells = ALLOC(BATCH_CELLS);
+                buffer->jobs = CALLOC(batch.threads, sizeof(BatchJob));
+                buffer->workers = CALLOC(batch.threads, sizeof(pthread_t));
+        }
+
+        double start = batchNow();
+        if (count == 0) {
+                batchReadName(&batch, "-");
+        }
+        for (int i = 0; i < count; i++) {
+                batchReadName(&batch, names[i]);
+        }
+        /* checking the last boards read, then waiting for them */
+        batchHandOff(&batch);
+        batchFinish(&batch, &batch.buffers[1 - batch.current]);
+        double seconds = batchNow() - start;
+
+        long *totals = batch.totals;
+        long length = totals[BOARD_VALID] + totals[BOARD_INVALID] +
+                      totals[BOARD_MALFORMED];
+        fprintf(stderr, "%ld boards: %ld valid, %ld invalid, %ld malformed; "
+                "read and checked in %.6f s with %d threads "
+                "(%.0f boards/s)\n", length, totals[BOARD_VALID],
+                totals[BOARD_INVALID], totals[BOARD_MALFORMED], seconds,
+                batch.threads, seconds > 0 ? length / seconds : 0.0);
+
+        bool allValid = totals[BOARD_VALID] == length;
+        for (int b = 0; b < 2; b++) {
+                FREE(batch.buffers[b].boards);
+                FREE(batch.buffers[b].cells);
+                FREE(batch.buffers[b].jobs);
+                FREE(batch.buffers[b].workers);
+        }
+        for (int i = 0; i < batch.sourceCount; i++) {
+                FREE(batch.sources[i]);
+        }
+        FREE(batch.sources);
+        return allValid;
+}
+
+/**********batchHandOff********
+ * About: This function waits for the boards of the other buffer and
+ *        reports them, then starts checking the boards of the buffer being
+ *        filled and fills the other one from then on
+ * Inputs:
+ * Batch *batch: the batch
+ * Return: none
+************************/
+void batchHandOff(Batch *batch) {
+        batchFinish(batch, &batch->buffers[1 - batch->current]);
+        batchStart(batch, &batch->buffers[batch->current]);
+        batch->current = 1 - batch->current;
+}
+
+/**********batchStart********
+ * About: This function splits the boards of a buffer evenly between the
+ *        threads and starts them. A job whose thread cannot be created is
+ *        checked by the calling thread instead.
+ * Inputs:
+ * Batch *batch: the batch
+ * BatchBuffer *buffer: the buffer, which is not changed until batchFinish
+ * Return: none
+************************/
+void batchStart(Batch *batch, BatchBuffer *buffer) {
+        int threads = batch->threads;
+        if (threads > buffer->length) {
+                threads = buffer->length;
+        }
+        for (int t = 0; t < threads; t++) {
+                BatchJob *job = &buffer->jobs[t];
+                int first = (int)((long)buffer->length * t / threads);
+                int last = (int)((long)buffer->length * (t + 1) / threads);
+                job->boards = buffer->boards + first;
+                job->length = last - first;
+                job->started = pthread_create(&buffer->workers[t], NULL,
+                                              batchWorker, job) == 0;
+                if (!job->started) {
+                        batchWorker(job);
+                }
+        }
+}
+
+/**********batchFinish********
+ * About: This function waits for the threads of a buffer, prints one line
+ *        per board in input order and empties the buffer
+ * Inputs:
+ * Batch *batch: the batch, whose totals are updated
+ * BatchBuffer *buffer: the buffer
+ * Return: none
+************************/
+void batchFinish(Batch *batch, BatchBuffer *buffer) {
+        for (int t = 0; t < batch->threads; t++) {
+                if (buffer->jobs[t].started) {
+                        pthread_join(buffer->workers[t], NULL);
+                        buffer->jobs[t].started = false;
+                }
+        }
+
+        static const char *resultNames[] = { "valid", "invalid", "malformed" };
+        for (int i = 0; i < buffer->length; i++) {
+                Board *board = &buffer->boards[i];
+                fprintf(batch->out, "%s:%d %s\n",
+                        batch->sources[board->source], board->index,
+                        resultNames[board->result]);
+                batch->totals[board->result]++;
+        }
+        buffer->length = 0;
+        buffer->cellsLength = 0;
+}
+
+/**********batchReadName********
+ * About: This function reads the boards of a file or of every regular file
+ *        in a directory
+ * Inputs:
+ * Batch *batch: the batch the boards are added to
+ * const char *name: the name of the file or directory, "-" for stdin
+ * Return: none
+************************/
+void batchReadName(Batch *batch, const char *name) {
+        struct stat info;
+        if (strcmp(name, "-") != 0 && stat(name, &info) == 0 &&
+            S_ISDIR(info.st_mode)) {
+                batchReadDirectory(batch, name);
+        }
+        else {
+                batchReadFile(batch, name);
+        }
+}
+
+/**********batchReadDirectory********
+ * About: This function reads the boards of every regular file in a
+ *        directory, in the order of their names. Names starting with a dot
+ *        are skipped.
+ * Inputs:
+ * Batch *batch: the batch the boards are added to
+ * const char *name: the name of the directory
+ * Return: none
+************************/
+void batchReadDirectory(Batch *batch, const char *name) {
+        DIR *dir = opendir(name);
+        if (dir == NULL) {
+                fprintf(stderr, "sudoku: cannot open directory %s\n", name);
+                return;
+        }
+
+        /* collecting the paths first so they can be sorted */
+        int length = 0, capacity = 64;
+        char **paths = ALLOC(capacity * sizeof(char *));
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+                if (entry->d_name[0] == '.') {
+                        continue;
+                }
+                size_t size = strlen(name) + strlen(entry->d_name) + 2;
+                char *path = ALLOC(size);
+                snprintf(path, size, "%s/%s", name, entry->d_name);
+                struct stat info;
+                if (stat(path, &info) != 0 || !S_ISREG(info.st_mode)) {
+                        FREE(path);
+                        continue;
+                }
+                if (length == capacity) {
+                        capacity *= 2;
+                        RESIZE(paths, capacity * sizeof(char *));
+                }
+                paths[length++] = path;
+        }
+        closedir(dir);
+
+        qsort(paths, length, sizeof(char *), batchCompareNames);
+        for (int i = 0; i < length; i++) {
+                batchReadFile(batch, paths[i]);
+                FREE(paths[i]);
+        }
+        FREE(paths);
+}
+
+/**********batchReadFile********
+ * About: This function reads every board of a file, until the file ends or
+ *        a board cannot be read
+ * Inputs:
+ * Batch *batch: the batch the boards are added to
+ * const char *name: the name of the file, "-" for stdin
+ * Return: none
+************************/
+void batchReadFile(Batch *batch, const char *name) {
+        FILE *fp = strcmp(name, "-") == 0 ? stdin : fopen(name, "rb");
+        int source = batchAddSource(batch, name);
+        if (fp == NULL) {
+                batchAddBoard(batch, source, 0, 0)->result = BOARD_MALFORMED;
+                return;
+        }
+
+        for (int index = 0; ; index++) {
+                unsigned char packedCells[SUDOKU_CELLS];
+                int format = 0, side = SUDOKU_SIDE;
+                bool ended = false;
+                bool read;
+                if (batch->packed) {
+                        size_t got = fread(packedCells, 1, SUDOKU_CELLS, fp);
+                        ended = got == 0;
+                        read = got == SUDOKU_CELLS;
+                }
+                else {
+                        read = batchReadPgmHeader(fp, &format, &side, &ended);
+                }
+                if (ended) {
+                        break;
+                }
+                Board *board = batchAddBoard(batch, source, index,
+                                             read ? side : 0);
+                unsigned char *cells = board->cells;
+                if (read && batch->packed) {
+                        memcpy(cells, packedCells, SUDOKU_CELLS);
+                }
+                else if (read) {
+                        read = batchReadPgmCells(fp, format, cells, side);
+                }
+                if (!read) {
+                        board->result = BOARD_MALFORMED;
+                        break;
+                }
+        }
+        if (fp != stdin) {
+                fclose(fp);
+        }
+}
+
+/**********batchAddSource********
+ * About: This function adds a copy of a file name to the list of sources
+ * Inputs:
+ * Batch *batch: the batch
+ * const char *name: the name of the file
+ * Return: the index of the name in the list
+************************/
+int batchAddSource(Batch *batch, const char *name) {
+        if (batch->sourceCount == batch->sourceCapacity) {
+                batch->sourceCapacity = batch->sourceCapacity == 0 ? 16 :
+                                        2 * batch->sourceCapacity;
+                if (batch->sources == NULL) {
+                        batch->sources = ALLOC(batch->sourceCapacity *
+                                               sizeof(char *));
+                }
+                else {
+                        RESIZE(batch->sources, batch->sourceCapacity *
+                               sizeof(char *));
+                }
+        }
+        char *copy = ALLOC(strlen(name) + 1);
+        strcpy(copy, name);
+        batch->sources[batch->sourceCount] = copy;
+        return batch->sourceCount++;
+}
+
+/**********batchAddBoard********
+ * About: This function adds an empty board to the end of the buffer being
+ *        filled, handing the buffer off first if the board does not fit
+ * Inputs:
+ * Batch *batch: the batch
+ * int source: the index of the file of the board
+ * int index: the index of the board in its file
+ * int side: the side of the board, 0 for a board that was not read
+ * Return: the new board, whose cells the caller fills in
+************************/
+Board *batchAddBoard(Batch *batch, int source, int index, int side) {
+        long size = (long)side * side;
+        BatchBuffer *buffer = &batch->buffers[batch->current];
+        if (buffer->length == BATCH_BOARDS ||
+            buffer->cellsLength + size > BATCH_CELLS) {
+                batchHandOff(batch);
+                buffer = &batch->buffers[batch->current];
+        }
+
+        Board *board = &buffer->boards[buffer->length++];
+        board->cells = buffer->cells + buffer->cellsLength;
+        board->box = sudokuBoxSize(side);
+        buffer->cellsLength += size;
+        board->source = source;
+        board->index = index;
+        board->result = BOARD_UNCHECKED;
+        return board;
+}
+
+/**********batchReadPgmHeader********
+ * About: This function reads the header of the next pgm board of a stream,
+ *        in plain (P2) or raw (P5) format, which must be N * N by N * N
+ *        with maxval N * N for N from 1 to SUDOKU_MAX_BOX
+ * Inputs:
+ * FILE *fp: the stream
+ * int *format: where the format character ('2' or '5') is stored
+ * int *side: where the side of the board is stored
+ * bool *ended: set to true if the stream ended before the board started
+ * Return: true if a header was read, false otherwise
+************************/
+bool batchReadPgmHeader(FILE *fp, int *format, int *side, bool *ended) {
+        int c = batchSkipSpace(fp);
+        if (c == EOF) {
+                *ended = true;
+                return false;
+        }
+        *format = getc_unlocked(fp);
+        int width, height, maxval;
+        if (c != 'P' || (*format != '2' && *format != '5') ||
+            !batchReadNumber(fp, &width) || !batchReadNumber(fp, &height) ||
+            !batchReadNumber(fp, &maxval) || width != height ||
+            maxval != width || sudokuBoxSize(width) == 0) {
+                return false;
+        }
+        *side = width;
+        return true;
+}
+
+/**********batchReadPgmCells********
+ * About: This function reads the values of a pgm board whose header was
+ *        read by batchReadPgmHeader. A value above the maxval, or a raw
+ *        board not separated from its header by one whitespace byte, is
+ *        malformed.
+ * Inputs:
+ * FILE *fp: the stream
+ * int format: the format character of the header
+ * unsigned char *cells: where the side * side values are stored
+ * int side: the side of the board
+ * Return: true if every value was read and is at most the maxval, false
+ *         otherwise
+************************/
+bool batchReadPgmCells(FILE *fp, int format, unsigned char *cells, int side) {
+        size_t size = (size_t)side * side;
+        if (format == '5') {
+                /* a single whitespace byte separates the header from data */
+                int c = getc_unlocked(fp);
+                if ((c != ' ' && c != '\t' && c != '\n' && c != '\r') ||
+                    fread(cells, 1, size, fp) != size) {
+                        return false;
+                }
+                for (size_t i = 0; i < size; i++) {
+                        if (cells[i] > side) {
+                                return false;
+                        }
+                }
+                return true;
+        }
+        for (size_t i = 0; i < size; i++) {
+                int value;
+                if (!batchReadNumber(fp, &value) || value > side) {
+                        return false;
+                }
+                cells[i] = (unsigned char)value;
+        }
+        return true;
+}
+
+/**********batchSkipSpace********
+ * About: This function skips whitespace and comments (from '#' to the end
+ *        of the line) in a pgm stream
+ * Inputs:
+ * FILE *fp: the stream
+ * Return: the first other character, or EOF
+************************/
+int batchSkipSpace(FILE *fp) {
+        /* only this thread reads fp, so it need not be locked per byte once
+         * the workers have started */
+        int c = getc_unlocked(fp);
+        while (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '#') {
+                if (c == '#') {
+                        while (c != '\n' && c != EOF) {
+                                c = getc_unlocked(fp);
+                        }
+                }
+                c = getc_unlocked(fp);
+        }
+        return c;
+}
+
+/**********batchReadNumber********
+ * About: This function reads a decimal number from a pgm stream. A number
+ *        above 65535, the largest pgm maxval, is malformed.
+ * Inputs:
+ * FILE *fp: the stream
+ * int *value: where the number is stored
+ * Return: true if a number was read, false otherwise
+************************/
+bool batchReadNumber(FILE *fp, int *value) {
+        int c = batchSkipSpace(fp);
+        if (c < '0' || c > '9') {
+                return false;
+        }
+        int n = 0;
+        while (c >= '0' && c <= '9') {
+                n = n * 10 + (c - '0');
+                if (n > 65535) {
+                        return false;
+                }
+                c = getc_unlocked(fp);
+        }
+        ungetc(c, fp);
+        *value = n;
+        return true;
+}
+
+/**********batchCompareNames********
+ * About: This function compares two paths for qsort
+ * Inputs:
+ * const void *a, const void *b: pointers to the two char * paths
+ * Return: less than, equal to or greater than 0 as with strcmp
+************************/
+int batchCompareNames(const void *a, const void *b) {
+        return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**********batchWorker********
+ * About: This function is the body of a thread. It checks the boards of
+ *        its job that were read, leaving malformed ones as they are.
+ * Inputs:
+ * void *cl: the BatchJob of the thread
+ * Return: NULL
+************************/
+void *batchWorker(void *cl) {
+        BatchJob *job = cl;
+        for (int i = 0; i < job->length; i++) {
+                Board *board = &job->boards[i];
+                if (board->result != BOARD_UNCHECKED) {
+                        continue;
+                }
+                board->result = sudokuCheckBoard(board->cells, board->box) ?
+                                BOARD_VALID : BOARD_INVALID;
+        }
+        return NULL;
+}
+
+/**********batchNow********
+ * About: This function reads a monotonic clock
+ * Return: the time in seconds from an arbitrary start
+************************/
+double batchNow(void) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+}
@@ -0,0 +1,23 @@
+/*
+ *     sudokuBatch.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to validate many solved sudokus in one
+ *     run. The boards, of any side checked by sudokuCheck, are read from pgm
+ *     streams, directories of pgm files or packed 9 by 9 board files,
+ *     checked by a pool of threads, and reported one line per board with a
+ *     throughput summary at the end.
+ *
+ */
+
+#ifndef SUDOKUBATCH_INCLUDED
+#define SUDOKUBATCH_INCLUDED
+
+#include <stdio.h>
+#include <stdbool.h>
+
+extern bool sudokuBatch(int count, char *names[], bool packed, int threads,
+                        FILE *out);
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ *     sudokuCheck.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file checks solved sudokus of side N * N in a single pass.
+ *     Each row is turned into one 64 bit mask of columns per value v, with
+ *     bit c set when column c holds v. With SSE2 the row is loaded as
+ *     vectors of 16 bytes and every value is compared with all the bytes at
+ *     once (_mm_cmpeq_epi8), the matches being gathered into the mask with
+ *     _mm_movemask_epi8; without SSE2 the masks are built a cell at a time.
+ *     Since a row, column or box has N * N cells, it is valid exactly when
+ *     every value appears in it at least once, which also rules out values
+ *     outside 1 to N * N. A row is checked as soon as its masks are built,
+ *     the masks of a band of N rows are ORed together and checked box by
+ *     box at the end of the band, and the ORs of all bands are checked
+ *     column by column at the end. An invalid row or band stops the check
+ *     at once.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include <uarray2.h>
+#include <sudokuCheck.h>
+
+/* the bytes compared by one SSE2 instruction */
+#define CHUNK 16
+
+/* function declarations */
+bool sudokuCheckRows(const unsigned char *cells, int box);
+void sudokuRowMasks(const unsigned char *values, int side,
+                    uint64_t *where);
+
+/**********sudokuBoxSize********
+ * About: This function finds the box size of a sudoku with the given side
+ * Inputs:
+ * int side: the number of cells on a side of the sudoku
+ * Return: N if side is N * N for N from 1 to SUDOKU_MAX_BOX, 0 otherwise
+************************/
+int sudokuBoxSize(int side) {
+        for (int box = 1; box <= SUDOKU_MAX_BOX; box++) {
+                if (box * box == side) {
+                        return box;
+                }
+        }
+        return 0;
+}
+
+/**********sudokuCheckGrid********
+ * About: This function checks a sudoku held in a square UArray2_T of bytes
+ * Inputs:
+ * UArray2_T grid: the sudoku, with elements of type unsigned char
+ * Return: true if the sudoku is valid, false otherwise
+ * Expects
+ * - grid to be non-null, to hold unsigned chars, and to have a side of
+ *   N * N for N from 1 to SUDOKU_MAX_BOX
+************************/
+bool sudokuCheckGrid(UArray2_T grid) {
+        assert(grid != NULL);
+        assert(UArray2_size(grid) == sizeof(unsigned char));
+        assert(UArray2_width(grid) == UArray2_height(grid));
+        int box = sudokuBoxSize(UArray2_width(grid));
+        assert(box > 0);
+
+        /* the rows of a UArray2_T follow each other in memory */
+        return sudokuCheckRows(UArray2_row_unchecked(grid, 0), box);
+}
+
+/**********sudokuCheckBoard********
+ * About: This function checks a sudoku held in bytes in row major order
+ * Inputs:
+ * const unsigned char *cells: the (box * box) * (box * box) values
+ * int box: the number of cells on a side of a box
+ * Return: true if the sudoku is valid, false otherwise
+ * Expects
+ * - cells to be non-null and box to be from 1 to SUDOKU_MAX_BOX
+************************/
+bool sudokuCheckBoard(const unsigned char *cells, int box) {
+        assert(cells != NULL);
+        assert(box >= 1 && box <= SUDOKU_MAX_BOX);
+        return sudokuCheckRows(cells, box);
+}
+
+/**********sudokuCheckCells********
+ * About: This function checks a 9 by 9 sudoku held in 81 bytes in row major
+ *        order
+ * Inputs:
+ * const unsigned char *cells: the values of the sudoku
+ * Return: true if the sudoku is valid, false otherwise
+ * Expects
+ * - cells to be non-null and hold SUDOKU_CELLS bytes
+************************/
+bool sudokuCheckCells(const unsigned char *cells) {
+        return sudokuCheckBoard(cells, SUDOKU_BOX);
+}
+
+/**********sudokuCheckRows********
+ * About: This function checks the rows, boxes and columns of a sudoku in
+ *        one pass over its rows, as described at the top of the file
+ * Inputs:
+ * const unsigned char *cells: the values of the sudoku in row major order
+ * int box: the number of cells on a side of a box
+ * Return: true if the sudoku is valid, false otherwise
+************************/
+bool sudokuCheckRows(const unsigned char *cells, int box) {
+        int side = box * box;
+        uint64_t full = side == 64 ? ~(uint64_t)0 :
+                        ((uint64_t)1 << side) - 1;
+        uint64_t boxFull = ((uint64_t)1 << box) - 1;
+
+        /* the columns of each value in a row, its band and the whole grid */
+        uint64_t where[SUDOKU_MAX_SIDE];
+        uint64_t band[SUDOKU_MAX_SIDE] = { 0 };
+        uint64_t cols[SUDOKU_MAX_SIDE] = { 0 };
+
+        for (int row = 0; row < side; row++) {
+                sudokuRowMasks(cells + (long)row * side, side, where);
+                for (int v = 0; v < side; v++) {
+                        if (where[v] == 0) {
+                                return false;
+                        }
+                        band[v] |= where[v];
+                }
+
+                /* a band of box rows is done: checking its boxes */
+                if ((row + 1) % box != 0) {
+                        continue;
+                }
+                for (int v = 0; v < side; v++) {
+                        for (int first = 0; first < side; first += box) {
+                                if (((band[v] >> first) & boxFull) == 0) {
+                                        return false;
+                                }
+                        }
+                        cols[v] |= band[v];
+                        band[v] = 0;
+                }
+        }
+
+        /* every column must have seen every value */
+        for (int v = 0; v < side; v++) {
+                if (cols[v] != full) {
+                        return false;
+                }
+        }
+        return true;
+}
+
+/**********sudokuRowMasks********
+ * About: This function finds the columns of every value in a row
+ * Inputs:
+ * const unsigned char *values: the side values of the row
+ * int side: the number of cells in the row
+ * uint64_t *where: side masks, where[v - 1] getting bit c set when column c
+ *                  holds v; values outside 1 to side set no bit
+ * Return: none
+************************/
+void sudokuRowMasks(const unsigned char *values, int side,
+                    uint64_t *where) {
+#ifdef __SSE2__
+        /* padding the row to whole chunks with 0, which is never a value */
+        unsigned char padded[SUDOKU_MAX_SIDE] = { 0 };
+        memcpy(padded, values, side);
+
+        int chunks = (side + CHUNK - 1) / CHUNK;
+        __m128i bytes[SUDOKU_MAX_SIDE / CHUNK];
+        for (int k = 0; k < chunks; k++) {
+                bytes[k] = _mm_loadu_si128((const __m128i *)(padded +
+                                                             k * CHUNK));
+        }
+        for (int v = 0; v < side; v++) {
+                __m128i value = _mm_set1_epi8((char)(v + 1));
+                uint64_t mask = 0;
+                for (int k = 0; k < chunks; k++) {
+                        unsigned hits = (unsigned)_mm_movemask_epi8(
+                                        _mm_cmpeq_epi8(bytes[k], value));
+                        mask |= (uint64_t)hits << (k * CHUNK);
+                }
+                where[v] = mask;
+        }
+#else
+        for (int v = 0; v < side; v++) {
+                where[v] = 0;
+        }
+        for (int col = 0; col < side; col++) {
+                int v = values[col];
+                if (v >= 1 && v <= side) {
+                        where[v - 1] |= (uint64_t)1 << col;
+                }
+        }
+#endif
+}
+
+#undef CHUNK
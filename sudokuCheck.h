@@ -0,0 +1,34 @@
+/*
+ *     sudokuCheck.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to check if a solved sudoku held in memory
+ *     is valid. A sudoku has N x N boxes of N x N cells, so its side is N * N
+ *     cells, for N from 1 to 8 (up to 64 x 64 grids). The values are stored
+ *     one byte per cell, either in a UArray2_T (as read by sudoku) or as
+ *     side * side bytes in row major order.
+ *
+ */
+
+#ifndef SUDOKUCHECK_INCLUDED
+#define SUDOKUCHECK_INCLUDED
+
+#include <stdbool.h>
+#include <uarray2.h>
+
+/* the classic 9 x 9 sudoku */
+#define SUDOKU_BOX 3
+#define SUDOKU_SIDE (SUDOKU_BOX * SUDOKU_BOX)
+#define SUDOKU_CELLS (SUDOKU_SIDE * SUDOKU_SIDE)
+
+/* the largest sudoku that can be checked */
+#define SUDOKU_MAX_BOX 8
+#define SUDOKU_MAX_SIDE (SUDOKU_MAX_BOX * SUDOKU_MAX_BOX)
+
+extern int sudokuBoxSize(int side);
+extern bool sudokuCheckGrid(UArray2_T grid);
+extern bool sudokuCheckBoard(const unsigned char *cells, int box);
+extern bool sudokuCheckCells(const unsigned char *cells);
+
+#endif
@@ -0,0 +1,378 @@
+/*
+ *     tiledClear.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file clears the black edges of a Bit2_T bitmap with a pool
+ *     of threads. The rows are split into one tile per thread. Tiles are
+ *     bands of whole rows and are never split by columns, so each tile owns
+ *     the words of its rows and no two threads write the same word. Each
+ *     thread labels the black runs of its tile with RunLabels, resolves
+ *     their local roots and marks the local components that reach an edge
+ *     of the image. Only the components with a run on the first or last row
+ *     of a tile can continue into another tile, so only those are placed in
+ *     a small union-find forest, which is joined along the rows where two
+ *     tiles meet. Finally each thread clears the runs of its own tile that
+ *     belong to a marked component. Every array is taken from a pool given
+ *     by the caller, which only the calling thread touches: the threads
+ *     first count the runs of their tiles, the arrays are then taken at
+ *     their final size, and the threads never allocate.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <bit2.h>
+#include <pool.h>
+#include <spanFill.h>
+#include <runLabel.h>
+#include <tiledClear.h>
+
+/**********struct TileJob********
+ * About: This struct holds the work of one thread: its rows, the labels of
+ *        its runs and the marks of the components that reach an edge.
+************************/
+typedef struct TileJob {
+        Bit2_T bitmap; /* the bitmap being cleared */
+        int firstRow; /* index of the first row of the tile */
+        int rows; /* number of rows in the tile */
+        long runs; /* number of black runs in the tile, counted first */
+        RunLabels labels; /* the runs of the tile, with every parent set to
+                             its local root once labelled */
+        unsigned char *onEdge; /* 1 for local roots that reach an edge */
+        long *portal; /* node of each local root in the boundary forest, or
+                         -1 for roots with no run on the first or last row */
+        long portals; /* number of boundary nodes of the tile */
+        long offset; /* the first boundary node of the tile in the forest */
+        const unsigned char *portalEdge; /* 1 for boundary nodes whose
+                                            merged component reaches an
+                                            edge, indexed like the forest */
+        pthread_t thread; /* the thread working on the tile */
+        bool started; /* true while thread has to be joined */
+} TileJob;
+
+/* function declarations */
+void tileRunAll(TileJob *jobs, int tiles, void *work(void *job));
+void *tileCount(void *job);
+void *tileLabel(void *job);
+void *tileClear(void *job);
+void tileMarkRow(TileJob *tile, int row);
+bool tileMerge(TileJob *jobs, int tiles, Pool_T pool);
+long tileNode(const TileJob *tile, long run);
+void tileJoin(long *parent, const TileJob *upper, const TileJob *lower);
+
+/**********tiledClearEdges********
+ * About: This function clears every black bit that is connected to an edge
+ * of the bitmap using the given number of threads
+ * Inputs:
+ * Bit2_T bitmap: 2D bit vector storing the bit values
+ * int threads: the number of threads to use, or 0 (or less) to use one
+ *              thread per online processor
+ * Pool_T pool: the pool the tiles and their labels are taken from, which
+ *              keeps them until the caller resets it
+ * Return: true if the edges were cleared, false if the pool ran out of
+ *         memory, leaving the bitmap unchanged
+ * Expects
+ * - bitmap and pool to be non-null
+************************/
+bool tiledClearEdges(Bit2_T bitmap, int threads, Pool_T pool) {
+        assert(bitmap != NULL && pool != NULL);
+
+        int height = Bit2_height(bitmap);
+        if (threads <= 0) {
+                threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        }
+        int tiles = threads < 1 ? 1 : threads > height ? height : threads;
+
+        /* splitting the rows as evenly as possible */
+        TileJob *jobs = Pool_calloc(pool, tiles, (long)sizeof(TileJob));
+        if (jobs == NULL) {
+                return false;
+        }
+        for (int t = 0; t < tiles; t++) {
+                jobs[t].bitmap = bitmap;
+                jobs[t].firstRow = (int)((long)height * t / tiles);
+                jobs[t].rows = (int)((long)height * (t + 1) / tiles) - 
+                               jobs[t].firstRow;
+        }
+
+        /* 
+         * taking the arrays of every tile here, once its runs are known, so
+         * that running out of memory is seen before any bit is cleared
+         */
+        tileRunAll(jobs, tiles, tileCount);
+        for (int t = 0; t < tiles; t++) {
+                TileJob *tile = &jobs[t];
+                if (!RunLabels_alloc(&tile->labels, tile->firstRow,
+                                     tile->rows, tile->runs, pool)) {
+                        return false;
+                }
+                if (tile->runs > 0) {
+                        tile->onEdge = Pool_calloc(pool, tile->runs, 1);
+                        tile->portal = Pool_alloc(pool, tile->runs *
+                                                  (long)sizeof(long));
+                        if (tile->onEdge == NULL || tile->portal == NULL) {
+                                return false;
+                        }
+                }
+        }
+
+        tileRunAll(jobs, tiles, tileLabel);
+        if (!tileMerge(jobs, tiles, pool)) {
+                return false;
+        }
+        tileRunAll(jobs, tiles, tileClear);
+        return true;
+}
+
+/**********tileRunAll********
+ * About: This function runs the given work on every tile, one thread per
+ * tile, and waits for all of them to finish. A single tile is worked on by
+ * the calling thread, and so is any tile whose thread cannot be created.
+ * Inputs:
+ * TileJob *jobs: the tiles
+ * int tiles: the number of tiles
+ * void *work(void *job): the function to run on each tile
+ * Return: none
+************************/
+void tileRunAll(TileJob *jobs, int tiles, void *work(void *job)) {
+        if (tiles == 1) {
+                work(&jobs[0]);
+                return;
+        }
+
+        for (int t = 0; t < tiles; t++) {
+                jobs[t].started = pthread_create(&jobs[t].thread, NULL, work,
+                                                 &jobs[t]) == 0;
+                if (!jobs[t].started) {
+                        work(&jobs[t]);
+                }
+        }
+        for (int t = 0; t < tiles; t++) {
+                if (jobs[t].started) {
+                        pthread_join(jobs[t].thread, NULL);
+                        jobs[t].started = false;
+                }
+        }
+}
+
+/**********tileCount********
+ * About: This function is run by a thread to count the black runs of its
+ * tile, so that the arrays of the tile can be allocated at their final size
+ * Inputs:
+ * void *job: the TileJob of the tile
+ * Return: NULL
+************************/
+void *tileCount(void *job) {
+        TileJob *tile = job;
+        tile->runs = RunLabels_count(tile->bitmap, tile->firstRow, tile->rows);
+        return NULL;
+}
+
+/**********tileLabel********
+ * About: This function is run by a thread to label the runs of its tile in
+ * the arrays taken for it. The parent of every run is set to its local root,
+ * the roots of runs on an edge of the image are marked, and the roots with a
+ * run on the first or last row of the tile are given a node in the boundary
+ * forest.
+ * Inputs:
+ * void *job: the TileJob of the tile
+ * Return: NULL
+************************/
+void *tileLabel(void *job) {
+        TileJob *tile = job;
+        RunLabels *labels = &tile->labels;
+        int width = Bit2_width(tile->bitmap);
+        int height = Bit2_height(tile->bitmap);
+
+        RunLabels_fill(labels, tile->bitmap);
+        if (labels->length == 0) {
+                return NULL;
+        }
+
+        for (int i = 0; i < labels->rows; i++) {
+                int row = labels->firstRow + i;
+                for (long run = labels->rowStart[i]; 
+                     run < labels->rowStart[i + 1]; run++) {
+                        long root = RunLabels_find(labels->parent, run);
+                        labels->parent[run] = root;
+                        tile->portal[run] = -1;
+                        if (row == 0 || row == height - 1 ||
+                            labels->first[run] == 0 ||
+                            labels->last[run] == width - 1) {
+                                tile->onEdge[root] = 1;
+                        }
+                }
+        }
+
+        tileMarkRow(tile, tile->firstRow);
+        tileMarkRow(tile, tile->firstRow + tile->rows - 1);
+        return NULL;
+}
+
+/**********tileMarkRow********
+ * About: This function gives every local root with a run on the given row a
+ * node in the boundary forest, if it does not have one yet
+ * Inputs:
+ * TileJob *tile: the labelled tile
+ * int row: index of the row in the bitmap, which is in the tile
+ * Return: none
+************************/
+void tileMarkRow(TileJob *tile, int row) {
+        RunLabels *labels = &tile->labels;
+        int i = row - labels->firstRow;
+
+        for (long run = labels->rowStart[i]; run < labels->rowStart[i + 1];
+             run++) {
+                long root = labels->parent[run];
+                if (tile->portal[root] < 0) {
+                        tile->portal[root] = tile->portals++;
+                }
+        }
+}
+
+/**********tileClear********
+ * About: This function is run by a thread to clear the runs of its tile that
+ * belong to a component reaching an edge. Only the rows of the tile are
+ * written, so the threads never touch the same words.
+ * Inputs:
+ * void *job: the TileJob of the tile
+ * Return: NULL
+************************/
+void *tileClear(void *job) {
+        TileJob *tile = job;
+        RunLabels *labels = &tile->labels;
+
+        if (labels->length == 0) {
+                return NULL;
+        }
+        for (int i = 0; i < labels->rows; i++) {
+                Bit2_word *span = Bit2_row_mut(tile->bitmap,
+                                               labels->firstRow + i);
+                for (long run = labels->rowStart[i]; 
+                     run < labels->rowStart[i + 1]; run++) {
+                        long root = labels->parent[run];
+                        long node = tile->portal[root];
+                        if (tile->onEdge[root] || (node >= 0 && 
+                            tile->portalEdge[tile->offset + node])) {
+                                spanClearRange(span, labels->first[run],
+                                               labels->last[run]);
+                        }
+                }
+        }
+        return NULL;
+}
+
+/**********tileMerge********
+ * About: This function places the boundary nodes of all tiles in one forest,
+ * joins them along the rows where two tiles meet, and marks every node whose
+ * merged component reaches an edge of the image. Only the runs on the first
+ * and last rows of the tiles are visited here; the rest of the work is done
+ * by the threads.
+ * Inputs:
+ * TileJob *jobs: the labelled tiles, which get their offset and portalEdge
+ *                set
+ * int tiles: the number of tiles
+ * Pool_T pool: the pool the forest and its marks are taken from
+ * Return: true if the nodes were merged, false if the pool ran out of
+ *         memory
+************************/
+bool tileMerge(TileJob *jobs, int tiles, Pool_T pool) {
+        long total = 0;
+
+        for (int t = 0; t < tiles; t++) {
+                jobs[t].offset = total;
+                total += jobs[t].portals;
+        }
+        if (total == 0) {
+                return true;
+        }
+
+        /* every node starts as its own tree with the mark of its root */
+        long *parent = Pool_alloc(pool, total * (long)sizeof(long));
+        unsigned char *edge = Pool_alloc(pool, total);
+        if (parent == NULL || edge == NULL) {
+                return false;
+        }
+        for (int t = 0; t < tiles; t++) {
+                TileJob *tile = &jobs[t];
+                for (long run = 0; run < tile->labels.length; run++) {
+                        long root = tile->labels.parent[run];
+                        if (root == run && tile->portal[root] >= 0) {
+                                long node = tile->offset + tile->portal[root];
+                                parent[node] = node;
+                                edge[node] = tile->onEdge[root];
+                        }
+                }
+        }
+
+        /* joining the last row of each tile with the first of the next */
+        for (int t = 1; t < tiles; t++) {
+                tileJoin(parent, &jobs[t - 1], &jobs[t]);
+        }
+
+        /* gathering the marks at the roots, then handing them back */
+        for (long node = 0; node < total; node++) {
+                if (edge[node]) {
+                        edge[RunLabels_find(parent, node)] = 1;
+                }
+        }
+        for (long node = 0; node < total; node++) {
+                edge[node] = edge[RunLabels_find(parent, node)];
+        }
+
+        for (int t = 0; t < tiles; t++) {
+                jobs[t].portalEdge = edge;
+        }
+        return true;
+}
+
+/**********tileNode********
+ * About: This function finds the boundary node of a run on the first or last
+ * row of a tile
+ * Inputs:
+ * const TileJob *tile: the labelled tile
+ * long run: the label of the run in the tile
+ * Return: the node of the run's component in the boundary forest
+************************/
+long tileNode(const TileJob *tile, long run) {
+        return tile->offset + tile->portal[tile->labels.parent[run]];
+}
+
+/**********tileJoin********
+ * About: This function joins the nodes of every run on the last row of a
+ * tile with those of the runs on the first row of the next tile that share
+ * a column with it, walking both rows together like RunLabels_join
+ * Inputs:
+ * long *parent: the union-find parents of the boundary forest
+ * const TileJob *upper: the upper tile
+ * const TileJob *lower: the tile right below it
+ * Return: none
+************************/
+void tileJoin(long *parent, const TileJob *upper, const TileJob *lower) {
+        const RunLabels *up = &upper->labels;
+        const RunLabels *down = &lower->labels;
+
+        long a = up->rowStart[up->rows - 1];
+        long aEnd = up->rowStart[up->rows];
+        long b = down->rowStart[0];
+        long bEnd = down->rowStart[1];
+
+        while (a < aEnd && b < bEnd) {
+                if (up->first[a] <= down->last[b] &&
+                    down->first[b] <= up->last[a]) {
+                        RunLabels_union(parent, tileNode(upper, a),
+                                        tileNode(lower, b));
+                }
+                /* moving past whichever run ends first */
+                if (up->last[a] < down->last[b]) {
+                        a++;
+                }
+                else {
+                        b++;
+                }
+        }
+}
@@ -0,0 +1,22 @@
+/*
+ *     tiledClear.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file holds a multi-threaded edge clearing engine. The
+ *     Bit2_T bitmap is split into tiles of whole rows whose black components
+ *     are found in parallel, the tiles are merged along their shared rows,
+ *     and the components that reach an edge of the image are cleared in
+ *     parallel.
+ *
+ */
+
+#ifndef TILEDCLEAR_INCLUDED
+#define TILEDCLEAR_INCLUDED
+
+#include <bit2.h>
+#include <pool.h>
+
+extern bool tiledClearEdges(Bit2_T bitmap, int threads, Pool_T pool);
+
+#endif
@@ -7,7 +7,8 @@
  *     store data in a 2D array. It also has functions that helps the client
  *     to get the width, height, and element size information about the array, 
  *     traverse the array in row major and column major orders, access to an
- *     element at a certain location, and free the UArray.
+ *     element at a certain location, and free the UArray. The elements are
+ *     stored contiguously in row major order.
  */
 
 #include <stdio.h>
@@ -15,23 +16,10 @@
 #include <assert.h>
 #include <mem.h>
 #include <uarray2.h>
-#include <uarray.h>
 #include <except.h>
 
 #define T2 UArray2_T
 
-/**********struct T2********
- * About: This struct holds a UArray instance that represents a 2D array and
- *        the row, column, and element size information for that array.
-************************/
-struct T2 {
-        int rows; /* number of rows in in the 2D array, at least 1 */
-        int cols; /* number of cols in in the 2D array, at least 1 */
-        int elmSize; /* number of elements in the 2D array */
-        UArray_T data; /* UArray_T representing the 2D array*/
-};
-
-
 /**********UArray2_new********
  * About: This function initializes a T2 struct and assigns the given values
  *        such as row, col, elementSize to the struct variables.
@@ -63,9 +51,13 @@ T2 UArray2_new(int col, int row, int elementSize) {
         array2D->cols = col;
         array2D->elmSize = elementSize;
 
-        /* creating the array */
-        array2D->data = UArray_new(row * col, elementSize);
-        assert(array2D->data != NULL);
+        /* creating the array with every element zeroed; CALLOC does not
+         * take a count of 0, so an empty array holds no storage */
+        array2D->elems = NULL;
+        if ((long)row * col > 0) {
+                array2D->elems = CALLOC((long)row * col, elementSize);
+                assert(array2D->elems != NULL);
+        }
 
         return array2D;
 }
@@ -138,7 +130,7 @@ void *UArray2_at(T2 array, int col, int row) {
 
         assert(col >= 0 && col < UArray2_width(array));
         assert(row >= 0 && row < UArray2_height(array));
-        return UArray_at(array->data, row * array->cols + col);
+        return UArray2_at_unchecked(array, col, row);
 }
 
 /**********UArray2_map_row_major********
@@ -161,7 +153,8 @@ void UArray2_map_row_major(T2 array, void apply(int col, int row,
         /* creating a nested loop such that column indices vary more rapidly */
         for (int i = 0; i < array->rows; i++) {
                 for (int j = 0; j < array->cols; j++) {
-                        apply(j, i, array, UArray2_at(array, j, i), cl);
+                        apply(j, i, array, UArray2_at_unchecked(array, j, i),
+                              cl);
                 }
         }
 }
@@ -186,11 +179,37 @@ void UArray2_map_col_major(T2 array, void apply(int col, int row,
         /* creating a nested loop such that row indices vary more rapidly */
         for (int j = 0; j < array->cols; j++) {
                 for (int i = 0; i < array->rows; i++) {
-                        apply(j, i, array, UArray2_at(array, j, i), cl);
+                        apply(j, i, array, UArray2_at_unchecked(array, j, i),
+                              cl);
                 }
         }
 }
 
+/**********UArray2_map_rows********
+ * About: This function traverses the 2D UArray a row at a time, from the
+ * first row to the last, giving apply all the elements of each row instead
+ * of one element per call
+ * Inputs:
+ * T2 array: struct to store the content of the given data in 2D UArray
+ * apply function: the function to be applied on every row; it gets the row
+ *                 index, a pointer to the first element of the row and the
+ *                 number of elements in the row, which follow each other
+ * cl pointer: client specific pointer input
+ * Return: none
+ * Expects
+ * - non-null T2 array
+************************/
+void UArray2_map_rows(T2 array, void apply(int row, void *elems, int length,
+                      T2 array, void *p1), void *cl) {
+
+        assert(array != NULL);
+
+        for (int i = 0; i < array->rows; i++) {
+                apply(i, UArray2_row_unchecked(array, i), array->cols, array,
+                      cl);
+        }
+}
+
 /**********UArray2_free********
  * About: This function frees the memory allocated to the 2D UArray and the T2
  *        struct
@@ -205,9 +224,8 @@ void UArray2_free(T2 *array) {
 
         assert(*array!= NULL && array != NULL);
 
-        /* freeing the UArray held by the struct */
-        UArray_T arrayToFree = (*array)->data;
-        UArray_free(&arrayToFree);
+        /* freeing the elements held by the struct */
+        FREE((*array)->elems);
 
         /* freeing the struct */
         FREE(*array);
@@ -7,13 +7,19 @@
  *     store the data. It also has functions that helps the client to get the 
  *     width, height, and element size information about the array, traverse 
  *     the array in row major and column major order and access to an element 
- *     at a certain location.
+ *     at a certain location. Unchecked accessors are defined inline below for
+ *     inner loops that have already checked their indices; compiling with
+ *     -DUARRAY2_CHECKED makes them assert their indices like UArray2_at does.
  *     
  */
 
 #ifndef UARRAY2_INCLUDED
 #define UARRAY2_INCLUDED
 
+#ifdef UARRAY2_CHECKED
+#include <assert.h>
+#endif
+
 #define T2 UArray2_T
 typedef struct T2 *T2;
 
@@ -28,7 +34,41 @@ extern void UArray2_map_row_major(T2 array, void apply(int col,
 extern void UArray2_map_col_major(T2 array, void apply(int col, 
                                   int row, T2 array, void *p1, 
                                   void *p2), void *cl);
+extern void UArray2_map_rows(T2 array, void apply(int row, void *elems,
+                             int length, T2 array, void *p1), void *cl);
 extern void UArray2_free(T2 *array);
 
+/* The representation is only visible so that the unchecked accessors can be
+ * inlined; clients should not touch its fields. */
+struct T2 {
+        int rows; /* number of rows in in the 2D array, at least 1 */
+        int cols; /* number of cols in in the 2D array, at least 1 */
+        int elmSize; /* size of an element in bytes */
+        char *elems; /* rows * cols elements stored in row major order */
+};
+
+#ifdef UARRAY2_CHECKED
+#define UARRAY2_CHECK(e) assert(e)
+#else
+#define UARRAY2_CHECK(e) ((void)0)
+#endif
+
+/* UArray2_at without the checks */
+static inline void *UArray2_at_unchecked(T2 array, int col, int row)
+{
+        UARRAY2_CHECK(col >= 0 && col < array->cols);
+        UARRAY2_CHECK(row >= 0 && row < array->rows);
+        return array->elems + ((long)row * array->cols + col) *
+               array->elmSize;
+}
+
+/* the first element of a row; the row's elements follow it contiguously */
+static inline void *UArray2_row_unchecked(T2 array, int row)
+{
+        UARRAY2_CHECK(row >= 0 && row < array->rows);
+        return array->elems + (long)row * array->cols * array->elmSize;
+}
+
+#undef UARRAY2_CHECK
 #undef T2
 #endif
\ No newline at end of file
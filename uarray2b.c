@@ -0,0 +1,290 @@
+/*
+ *     uarray2b.c
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to create a blocked 2D array where a
+ *     client can store data. The array is cut into blocksize x blocksize
+ *     blocks which are stored one after another in row major order of the
+ *     blocks, and the cells of each block are stored in row major order
+ *     inside it. Blocks on the right and bottom edges are padded to the
+ *     full block size; the padding cells are never visited.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <mem.h>
+#include <uarray2b.h>
+#include <except.h>
+
+#define T2 UArray2b_T
+
+/* the number of bytes UArray2b_new_64K_block tries to fit a block in */
+#define BLOCK_BYTES (64 * 1024)
+
+/**********struct T2********
+ * About: This struct holds the elements of a blocked 2D array along with
+ *        its size, element size and block size.
+************************/
+struct T2 {
+        int rows; /* number of rows in the 2D array, at least 1 */
+        int cols; /* number of cols in the 2D array, at least 1 */
+        int elmSize; /* size of an element in bytes */
+        int blocksize; /* number of cells on a side of a block */
+        int blockCols; /* number of blocks on a row of blocks */
+        int blockRows; /* number of rows of blocks */
+        char *elems; /* the blocks, each blocksize * blocksize elements */
+};
+
+/* function declarations */
+static inline void *blockCell(T2 array, int col, int row);
+
+/**********UArray2b_new********
+ * About: This function initializes a T2 struct with the given size and
+ *        block size, with every element set to 0
+ * Inputs:
+ * int col: number of columns in the 2D array
+ * int row: number of rows in the 2D array
+ * int elementSize: the size of an element in bytes
+ * int blocksize: the number of cells on a side of a block
+ * Return: a struct holding a blocked 2D array
+ * Expects
+ * - col, row, elementSize and blocksize to be greater than 0
+************************/
+T2 UArray2b_new(int col, int row, int elementSize, int blocksize) {
+        assert(col > 0 && row > 0 && elementSize > 0 && blocksize > 0);
+
+        T2 array2D;
+        NEW(array2D);
+        assert(array2D != NULL);
+
+        array2D->rows = row;
+        array2D->cols = col;
+        array2D->elmSize = elementSize;
+        array2D->blocksize = blocksize;
+        array2D->blockCols = (col + blocksize - 1) / blocksize;
+        array2D->blockRows = (row + blocksize - 1) / blocksize;
+
+        /* creating the blocks with every element (padding included) zeroed */
+        array2D->elems = CALLOC((long)array2D->blockCols * array2D->blockRows *
+                                blocksize * blocksize, elementSize);
+        assert(array2D->elems != NULL);
+
+        return array2D;
+}
+
+/**********UArray2b_new_64K_block********
+ * About: This function initializes a T2 struct like UArray2b_new, with the
+ *        largest block size that keeps a block within 64KB (at least 1)
+ * Inputs:
+ * int col: number of columns in the 2D array
+ * int row: number of rows in the 2D array
+ * int elementSize: the size of an element in bytes
+ * Return: a struct holding a blocked 2D array
+ * Expects
+ * - col, row and elementSize to be greater than 0
+************************/
+T2 UArray2b_new_64K_block(int col, int row, int elementSize) {
+        assert(elementSize > 0);
+        int blocksize = (int)sqrt((double)BLOCK_BYTES / elementSize);
+        if (blocksize < 1) {
+                blocksize = 1;
+        }
+        return UArray2b_new(col, row, elementSize, blocksize);
+}
+
+/**********UArray2b_width********
+ * About: This function returns the width (col number) of the 2D array
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * Return: the width of the array
+ * Expects
+ * - that array is non-null
+************************/
+int UArray2b_width(T2 array) {
+        assert(array != NULL);
+        return array->cols;
+}
+
+/**********UArray2b_height********
+ * About: This function returns the height (row number) of the 2D array
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * Return: the height of the array
+ * Expects
+ * - that array is non-null
+************************/
+int UArray2b_height(T2 array) {
+        assert(array != NULL);
+        return array->rows;
+}
+
+/**********UArray2b_size********
+ * About: This function returns the size of an element of the 2D array
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * Return: the size of an element in bytes
+ * Expects
+ * - that array is non-null
+************************/
+int UArray2b_size(T2 array) {
+        assert(array != NULL);
+        return array->elmSize;
+}
+
+/**********UArray2b_blocksize********
+ * About: This function returns the number of cells on a side of a block
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * Return: the block size of the array
+ * Expects
+ * - that array is non-null
+************************/
+int UArray2b_blocksize(T2 array) {
+        assert(array != NULL);
+        return array->blocksize;
+}
+
+/**********UArray2b_at********
+ * About: This function returns a pointer to the element at the given col
+ *        and row
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * int col: col index of the element
+ * int row: row index of the element
+ * Return: a pointer to the element
+ * Expects
+ * - that array is non-null
+ * - that col and row are at least 0 and at most (UArray2b_width(array)-1)
+ *   and (UArray2b_height(array)-1) respectively
+************************/
+void *UArray2b_at(T2 array, int col, int row) {
+        assert(array != NULL);
+        assert(col >= 0 && col < array->cols);
+        assert(row >= 0 && row < array->rows);
+        return blockCell(array, col, row);
+}
+
+/**********blockCell********
+ * About: This function finds the element at the given col and row, first
+ *        finding its block and then its cell in the block
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * int col: col index of the element, in bounds
+ * int row: row index of the element, in bounds
+ * Return: a pointer to the element
+************************/
+static inline void *blockCell(T2 array, int col, int row) {
+        int bs = array->blocksize;
+        long block = (long)(row / bs) * array->blockCols + col / bs;
+        long cell = block * bs * bs + (row % bs) * bs + col % bs;
+        return array->elems + cell * array->elmSize;
+}
+
+/**********UArray2b_map********
+ * About: This function traverses the 2D array a block at a time, visiting
+ * every cell of a block before moving to the next block. The blocks are
+ * visited in row major order, and so are the cells inside each block, so
+ * the elements are visited in the order they are stored in.
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * apply function: the function to be applied on all the elements
+ * cl pointer: client specific pointer input
+ * Return: none
+ * Expects
+ * - non-null T2 array
+************************/
+void UArray2b_map(T2 array, void apply(int col, int row, T2 array, void *p1,
+                  void *p2), void *cl) {
+        assert(array != NULL);
+        int bs = array->blocksize;
+
+        for (int blockRow = 0; blockRow < array->blockRows; blockRow++) {
+                for (int blockCol = 0; blockCol < array->blockCols;
+                     blockCol++) {
+                        char *block = array->elems + ((long)blockRow *
+                                      array->blockCols + blockCol) * bs * bs *
+                                      array->elmSize;
+                        /* the cells of the block that are inside the array */
+                        int lastRow = (blockRow + 1) * bs < array->rows ?
+                                      (blockRow + 1) * bs : array->rows;
+                        int lastCol = (blockCol + 1) * bs < array->cols ?
+                                      (blockCol + 1) * bs : array->cols;
+                        for (int i = blockRow * bs; i < lastRow; i++) {
+                                char *cell = block + (long)(i % bs) * bs *
+                                             array->elmSize;
+                                for (int j = blockCol * bs; j < lastCol;
+                                     j++) {
+                                        apply(j, i, array, cell, cl);
+                                        cell += array->elmSize;
+                                }
+                        }
+                }
+        }
+}
+
+/**********UArray2b_map_row_major********
+ * About: This function traverses the 2D array such that column indices vary
+ * more rapidly than row indices
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * apply function: the function to be applied on all the elements
+ * cl pointer: client specific pointer input
+ * Return: none
+ * Expects
+ * - non-null T2 array
+************************/
+void UArray2b_map_row_major(T2 array, void apply(int col, int row, T2 array,
+                            void *p1, void *p2), void *cl) {
+        assert(array != NULL);
+
+        for (int i = 0; i < array->rows; i++) {
+                for (int j = 0; j < array->cols; j++) {
+                        apply(j, i, array, blockCell(array, j, i), cl);
+                }
+        }
+}
+
+/**********UArray2b_map_col_major********
+ * About: This function traverses the 2D array such that row indices vary
+ * more rapidly than column indices. Consecutive rows of a column are
+ * blocksize elements apart inside a block, instead of a whole row apart.
+ * Inputs:
+ * T2 array: the blocked 2D array
+ * apply function: the function to be applied on all the elements
+ * cl pointer: client specific pointer input
+ * Return: none
+ * Expects
+ * - non-null T2 array
+************************/
+void UArray2b_map_col_major(T2 array, void apply(int col, int row, T2 array,
+                            void *p1, void *p2), void *cl) {
+        assert(array != NULL);
+
+        for (int j = 0; j < array->cols; j++) {
+                for (int i = 0; i < array->rows; i++) {
+                        apply(j, i, array, blockCell(array, j, i), cl);
+                }
+        }
+}
+
+/**********UArray2b_free********
+ * About: This function frees the memory allocated to the blocked 2D array
+ *        and the T2 struct
+ * Inputs:
+ * T2 *array: address of the blocked 2D array
+ * Return: none
+ * Expects
+ * - that array and *array are non-null
+************************/
+void UArray2b_free(T2 *array) {
+        assert(array != NULL && *array != NULL);
+
+        FREE((*array)->elems);
+        FREE(*array);
+}
+
+#undef BLOCK_BYTES
+#undef T2
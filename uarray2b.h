@@ -0,0 +1,39 @@
+/*
+ *     uarray2b.h
+ *     by Doga Kilinc (dkilin01) & Cansu Birsen (cbirse01), September 28
+ *     HW2: iii
+ *
+ *     About: This file can be used to create a blocked 2D array where a
+ *     client can store the data. The elements are stored in square blocks
+ *     of blocksize x blocksize cells, and the cells of a block are next to
+ *     each other in memory, so walking down a column or through a block
+ *     stays in a few cache lines. Like uarray2.h, it has functions that help
+ *     the client to get the width, height, element size and block size of
+ *     the array, traverse the array in row major, column major and block
+ *     major order and access to an element at a certain location.
+ *
+ */
+
+#ifndef UARRAY2B_INCLUDED
+#define UARRAY2B_INCLUDED
+
+#define T2 UArray2b_T
+typedef struct T2 *T2;
+
+extern T2 UArray2b_new(int col, int row, int elementSize, int blocksize);
+extern T2 UArray2b_new_64K_block(int col, int row, int elementSize);
+extern int UArray2b_width(T2 array);
+extern int UArray2b_height(T2 array);
+extern int UArray2b_size(T2 array);
+extern int UArray2b_blocksize(T2 array);
+extern void *UArray2b_at(T2 array, int col, int row);
+extern void UArray2b_map(T2 array, void apply(int col, int row, T2 array,
+                         void *p1, void *p2), void *cl);
+extern void UArray2b_map_row_major(T2 array, void apply(int col, int row,
+                                   T2 array, void *p1, void *p2), void *cl);
+extern void UArray2b_map_col_major(T2 array, void apply(int col, int row,
+                                   T2 array, void *p1, void *p2), void *cl);
+extern void UArray2b_free(T2 *array);
+
+#undef T2
+#endif
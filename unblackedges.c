@@ -21,200 +21,297 @@
 #include <pnmrdr.h>
 #include <except.h>
 #include <pbmReadWrite.h>
-#include <seq.h>
+#include <streamClear.h>
+#include <frontier.h>
+#include <pool.h>
+#include <clearEngine.h>
+#include <cleanBatch.h>
+#include <cleanStats.h>
+#include <incrementalClear.h>
+
+/* the size of the chunks of the pool holding the stack and the arrays of
+ * the engine */
+#define CLEAN_POOL_CHUNK (1 << 20)
+
+/* the most bytes of rows -s may hold while they wait on open components */
+#define STREAM_HELD_BYTES (256L << 20)
 
 /* function declarations */
-void clearEdges(int col, int row, Bit2_T array, int bit, void *p1);
-void addToStack(Seq_T stack, int col, int row);
-void getTopStack(Seq_T stack, int *col, int *row);
-bool stackHandler(int col1, int row1, Bit2_T array, void *p1);
+Bit2_T readPrevious(char *program, char *name);
 
 /**********main********
  *
- * About: Opens the file or accepts information from stdin, calls pbmRead to 
- *        store bit values in a 2D bit vector, calls Bit2_map_row_major with
- *        clearEdges to clear the black edges of the file, and prints cleaned
- *        bit results to stdout
+ * About: Maps or opens the file or accepts information from stdin, calls
+ *        pbmRead to store bit values in a 2D bit vector, calls
+ *        engineClearEdges to clear the black edges of the file, and prints
+ *        cleaned bit results to stdout. The options are:
+ *        -r            print a raw (P4) file instead of a plain (P1) one
+ *        -e engine     dfs (the default), span, morph, tiled or label
+ *        -t threads    threads of the tiled engine, or of the -o workers
+ *        -s            stream the file, printing rows once they are final
+ *        -m            report the peak flood fill stack (or held rows)
+ *        -b            read into 8x8 blocks for the dfs engine
+ *        -i            JSON timings on stderr, like UNBLACKEDGES_STATS
+ *        -p/-P file    previous input/output; reclear changed parts only
+ *        -o directory  batch mode: clean every file into the directory
+ *        -l manifest   with -o, also clean the files listed in manifest
  * Inputs:
  * int argc: number of given arguments to start the program
  * char *argv: an array that stores the arguments
  * Return: EXIT_SUCCESS if the program comletes without any errors
- * Expects: argc to be 1 or 2, which is checked by openOrDie
+ * Expects: argc to be 1 or 2 after the options unless -o is given, which is
+ *          checked by openOrDie
  ************************/
 int main(int argc, char *argv[]) {
-        /* trying to open the file correctly */
-        FILE *fp = openOrDie(argc, argv);
+        int format = PBM_PLAIN;
+        Engine engine = ENGINE_DFS;
+        int threads = 0;
+        bool stream = false;
+        bool reportPeak = false;
+        bool blocked = false;
+        const char *outDir = NULL;
+        const char *manifest = NULL;
+        bool instrument = false;
+        char *prevInName = NULL;
+        char *prevOutName = NULL;
 
-        /* calling pgmHandler to see if the input is valid & store the input */
-        Bit2_T bitVector = pbmRead(fp);
+        /* handling the options given in front of the file name */
+        while (argc > 1 && argv[1][0] == '-' && argv[1][1] != '\0') {
+                if (strcmp(argv[1], "-r") == 0) {
+                        format = PBM_RAW;
+                }
+                else if (strcmp(argv[1], "-m") == 0) {
+                        reportPeak = true;
+                }
+                else if (strcmp(argv[1], "-s") == 0) {
+                        stream = true;
+                }
+                else if (strcmp(argv[1], "-b") == 0) {
+                        blocked = true;
+                }
+                else if (strcmp(argv[1], "-i") == 0) {
+                        instrument = true;
+                }
+                else if (strcmp(argv[1], "-e") == 0 && argc > 2 &&
+                         engineParse(argv[2], &engine)) {
+                        /* dropping the option, then its engine name below */
+                        argv[1] = argv[0];
+                        argv++;
+                        argc--;
+                }
+                else if (strcmp(argv[1], "-t") == 0 && argc > 2 &&
+                         atoi(argv[2]) > 0) {
+                        threads = atoi(argv[2]);
+                        /* dropping the option, then its count below */
+                        argv[1] = argv[0];
+                        argv++;
+                        argc--;
+                }
+                else if ((strcmp(argv[1], "-o") == 0 ||
+                          strcmp(argv[1], "-l") == 0 ||
+                          strcmp(argv[1], "-p") == 0 ||
+                          strcmp(argv[1], "-P") == 0) && argc > 2) {
+                        if (argv[1][1] == 'o') {
+                                outDir = argv[2];
+                        }
+                        else if (argv[1][1] == 'l') {
+                                manifest = argv[2];
+                        }
+                        else if (argv[1][1] == 'p') {
+                                prevInName = argv[2];
+                        }
+                        else {
+                                prevOutName = argv[2];
+                        }
+                        /* dropping the option, then its name below */
+                        argv[1] = argv[0];
+                        argv++;
+                        argc--;
+                }
+                else {
+                        fprintf(stderr, "usage: %s [-r] [-m] [-s] [-b] "
+                                "[-i] [-e dfs|span|morph|tiled|label] "
+                                "[-t threads] [-p previous -P cleaned] "
+                                "[file]\n"
+                                "       %s -o directory [-r] [-i] "
+                                "[-e dfs|span|morph|tiled|label] "
+                                "[-t threads] "
+                                "[-l manifest] [file ...]\n",
+                                argv[0], argv[0]);
+                        return EXIT_FAILURE;
+                }
+                /* dropping the option so openOrDie only sees the file */
+                argv[1] = argv[0];
+                argv++;
+                argc--;
+        }
+        if (instrument && stream) {
+                fprintf(stderr, "%s: -i needs the whole image, not -s\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+        instrument = statsEnabled(instrument);
+        if (manifest != NULL && outDir == NULL) {
+                fprintf(stderr, "%s: -l needs -o\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+        if ((prevInName == NULL) != (prevOutName == NULL)) {
+                fprintf(stderr, "%s: -p and -P go together\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+        bool incremental = prevInName != NULL;
+        if (outDir != NULL) {
+                if (stream || blocked || reportPeak || incremental) {
+                        fprintf(stderr, "%s: -s, -b, -m and -p take a single "
+                                "file, not -o\n", argv[0]);
+                        return EXIT_FAILURE;
+                }
+                bool allCleaned = cleanBatch(argc - 1, argv + 1, manifest,
+                                             outDir, engine, format, threads,
+                                             instrument);
+                return allCleaned ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
 
+        /* only the dfs engine works without row spans */
+        if (blocked && (stream || incremental || engine != ENGINE_DFS)) {
+                fprintf(stderr, "%s: -b needs the dfs engine, no -s and "
+                        "no -p\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+        if (stream && incremental) {
+                fprintf(stderr, "%s: -p needs the whole image, not -s\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
 
-        Seq_T neighbourStack = Seq_new(100);
-        Bit2_map_row_major(bitVector, clearEdges, neighbourStack);
-        
-        /* freeing the sequence itself */
-        Seq_free(&neighbourStack); 
+        if (stream) {
+                /* trying to open the file correctly */
+                FILE *fp = openOrDie(argc, argv);
+                PbmHeader header;
+                if (!pbmReadHeader(fp, &header)) {
+                        pbmBadFormat(fp, NULL);
+                }
+                long rowBytes = ((long)header.width + BIT2_WORD_BITS - 1) /
+                                BIT2_WORD_BITS * (long)sizeof(Bit2_word);
+                int maxRows = STREAM_HELD_BYTES / rowBytes > header.height ?
+                              header.height :
+                              (int)(STREAM_HELD_BYTES / rowBytes);
+                if (maxRows < 1) {
+                        maxRows = 1;
+                }
+                int peak = streamClearEdges(fp, &header, stdout, format,
+                                            maxRows);
+                if (peak < 0) {
+                        fflush(stdout);
+                        fprintf(stderr, "%s: -s would have to hold more than "
+                                "%d rows of this image at once; clean it "
+                                "without -s\n", argv[0], maxRows);
+                        fclose(fp);
+                        return EXIT_FAILURE;
+                }
+                if (reportPeak) {
+                        fprintf(stderr, "peak buffered rows: %d\n", peak);
+                }
+                fclose(fp);
+                return EXIT_SUCCESS;
+        }
 
-        /* pbm write */
-        pbmWrite(stdout, bitVector);
-        
-        /* freeing the 2D array and close the input stream */
-        Bit2_free(&bitVector);
-        fclose(fp);
-        
-        return EXIT_SUCCESS;
-}
+        CleanStats stats;
+        statsInit(&stats, argc == 2 ? argv[1] : "-", false);
 
-/**********addToStack********
- * About: This function is used to store information about the column and row 
- *        indices of a bit in a stack as a char array. 
- * Inputs:
- * Seq_T stack: The sequence structure used as a stack to store information
- * int col: column index value in the location info to be stored
- * int row: row index value in the location info to be stored
- * Expects
- * - Seq_T to be non-null, which is handled by Seq_new function
-************************/
-void addToStack(Seq_T stack, int col, int row) {
-        /* calculatign the length of location info and create a char array */
-        int maxLength = snprintf(NULL, 0, "%d,%d", col, row) + 1;
-        char *locationInfo = (char*)malloc(sizeof(char) * maxLength);
-        assert(locationInfo != NULL);
+        /* mapping a regular file, or opening stdin or a pipe as a stream */
+        statsStart(&stats);
+        MappedFile input = mapOrOpenOrDie(argc, argv);
 
-        /* placing the col and row indices into the locationInfo char array */
-        snprintf(locationInfo, maxLength, "%d,%d", col, row);
+        /* calling pbmRead to see if the input is valid & store the input,
+           straight into 8x8 blocks with -b */
+        Bit2_Layout layout = blocked ? BIT2_BLOCKED : BIT2_ROWS;
+        Bit2_T bitVector = input.data != NULL ? 
+                           pbmReadMappedLayout(input.data, input.length,
+                                               layout) :
+                           pbmReadLayout(input.fp, layout);
+        Bit2_T prevIn = NULL;
+        Bit2_T prevOut = NULL;
+        if (incremental) {
+                prevIn = readPrevious(argv[0], prevInName);
+                prevOut = readPrevious(argv[0], prevOutName);
+        }
+        statsStop(&stats, STATS_READ);
 
-        /* pushing locationInfo to tack */
-        Seq_addhi(stack, locationInfo);
-}
+        Pool_T pool = Pool_new(CLEAN_POOL_CHUNK);
+        Frontier_T neighbourStack = pool == NULL ? NULL :
+                                    Frontier_new_pool(100, pool);
+        if (neighbourStack == NULL) {
+                fprintf(stderr, "%s: out of memory\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+        if (instrument) {
+                statsBeforeClear(&stats, bitVector, neighbourStack);
+        }
+        statsStart(&stats);
 
-/**********getTopStack********
- * About: This function is used to access the  information about the column and
- *        row indices of a bit at the top of a stack as a char array
- * Inputs:
- * Seq_T stack: The sequence structure used as a stack to store information
- * int *col: pointer to column index value extracted from the location info 
- * int *row: pointer to row index value extracted from the location info 
- * Expects
- * - Seq_T to be non-null, which is handled by Seq_new function
- * - *col and *row to be non-null, which is handled by clearEdges function
-************************/
-void getTopStack(Seq_T stack, int *col, int *row) {
-        /* accessing the top of the stack */
-        char *locationInfo = Seq_get(stack, Seq_length(stack) - 1);
-        int colInfo = 0;
-        int rowInfo = 0;
+        bool cleared;
+        if (incremental && incrementalClearEdges(prevIn, prevOut, bitVector,
+                                                 neighbourStack)) {
+                cleared = !Frontier_failed(neighbourStack);
+        }
+        else {
+                cleared = engineClearEdges(engine, bitVector, neighbourStack,
+                                           pool, threads);
+        }
+        if (!cleared) {
+                fprintf(stderr, "%s: out of memory\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+        statsStop(&stats, STATS_CLEAR);
+        if (instrument) {
+                statsAfterClear(&stats, bitVector, neighbourStack, pool);
+        }
+        if (reportPeak) {
+                fprintf(stderr, "peak frontier: %ld entries, %ld bytes\n",
+                        Frontier_peak(neighbourStack),
+                        Frontier_peak_bytes(neighbourStack));
+        }
         
-        /* keeping track whether we are parsing col or row */
-        bool isParsingCol = true; 
+        /* freeing the stack and the arrays of the engine */
+        Frontier_free(&neighbourStack);
+        Pool_free(&pool);
+
+        /* pbm write */
+        statsStart(&stats);
+        pbmWrite(stdout, bitVector, format);
+        fflush(stdout);
+        statsStop(&stats, STATS_WRITE);
+        if (instrument) {
+                statsPrint(&stats, stderr);
+        }
         
-        for (int i = 0; locationInfo[i] != '\0'; i++) {
-                char currentChar = locationInfo[i];
-                /* if a comma is read, switch from parsing col to row */
-                if (currentChar == ',') {
-                        isParsingCol = false;
-                } 
-                else {
-                        /* updating col or row */
-                        if (isParsingCol) {
-                                colInfo = colInfo * 10 + (currentChar - '0');
-                        } 
-                        else {
-                                rowInfo = rowInfo * 10 + (currentChar - '0');
-                        }
-                }
+        /* freeing the 2D arrays and close the input */
+        Bit2_free(&bitVector);
+        if (incremental) {
+                Bit2_free(&prevIn);
+                Bit2_free(&prevOut);
         }
-        *row = rowInfo;
-        *col = colInfo;
+        closeMapped(&input);
+        
+        return EXIT_SUCCESS;
 }
 
-/**********clearEdges********
- * About: This function is used by the Bit2_map_row_major as an apply function.
- * It updates the bit values such that there are no black edge bits or black 
- * bits that are neighbours to black edges. 
+/**********readPrevious********
+ * About: This function reads a previous input or output given with -p or
+ * -P into a 2D bit vector, exiting like the input itself does when the file
+ * cannot be opened or is not a pbm file
  * Inputs:
- * int col: column index of the bit being visited
- * int row: row index of the bit being visited
- * Bit2_T array: 2D bit vector storing the bit values
- * int bit: value of the current bit being visited 
- * int *p1: pointer to the stack used to store bit location information 
- * Expects
- * - array to be non-null, which is handled by Bit2_new function
- * - *p1 to be non-null, which is handled by Seq_new function
- * - bit to be 0 or 1, which is a requirement of the pbm file and checked by
- * Pnmrdr interface
+ * char *program: the name of the program, for the error messages
+ * char *name: the name of the file
+ * Return: the bits of the file, which the caller frees with Bit2_free
 ************************/
-void clearEdges(int col, int row, Bit2_T array, int bit, void *p1) {
-        /* if the bit is white, no need to unblack */
-        if (bit == 0) 
-                return;
-        /* if the bit is not an edge bit, we skip */
-        if (col != 0 && row != 0 && col != Bit2_width(array) - 1 &&
-            row != Bit2_height(array) - 1) {
-                return;
-        }
-        /* making the bit white after adding it to the stack */
-        addToStack(p1, col, row);
-        Bit2_put(array, col, row, 0);
-       
-        /* while stack not empty, get top element and check its neighbors */
-        while (Seq_length(p1) != 0) {
-                int *row1 = (int*)malloc(sizeof(int) * 10);
-                int *col1 = (int*)malloc(sizeof(int) * 10);
-                assert(row1 != NULL && col1 != NULL);
-                getTopStack(p1, col1, row1);
-
-                bool hasBlackNeighbor = stackHandler(*col1, *row1, array, p1);
-                /* if bit has no black neighbors, remove bit from stack */
-                if (!hasBlackNeighbor) {
-                        free(Seq_remhi(p1));
-                }
-                free(row1);
-                free(col1);
-        }  
+Bit2_T readPrevious(char *program, char *name) {
+        char *args[] = { program, name };
+        MappedFile file = mapOrOpenOrDie(2, args);
+        Bit2_T bitmap = file.data != NULL ?
+                        pbmReadMapped(file.data, file.length) :
+                        pbmRead(file.fp);
+        closeMapped(&file);
+        return bitmap;
 }
-
-/**********stackHandler********
- * About: This function is used to see if the neighbors of the bit at 
- * [col1, row1] are black, and if they are, the function pushes their location
- * to the stack. 
- * Inputs:
- * int col1: column index of the bit being visited
- * int row1: row index of the bit being visited
- * Bit2_T array: 2D bit vector storing the bit values
- * int *p1: pointer to the stack used to store bit location information 
- * Returns: true if the current bit has any black neighbors, and false 
- * otherwise
- * Expects
- * - array to be non-null, which is handled by Bit2_new function
- * - *p1 to be non-null, which is handled by Seq_new function
-************************/
-bool stackHandler(int col1, int row1, Bit2_T array, void *p1) {
-        bool hasBlackNeighbor = false;
-
-        /* checking neighbors of the bit being visited and inserting the  
-         * location info to the stack if the neighbor is black */
-        if (col1 != 0 && Bit2_get(array, col1 - 1, row1) == 1) {
-                addToStack(p1, col1 - 1, row1);
-                Bit2_put(array, col1 - 1, row1, 0);
-                hasBlackNeighbor = true;       
-        }
-        else if (row1 != 0 && Bit2_get(array, col1, row1 - 1) == 1) {
-                addToStack(p1, col1, row1 - 1);
-                Bit2_put(array, col1, row1 - 1, 0);
-                hasBlackNeighbor = true;      
-        }
-        else if (col1 != Bit2_width(array) - 1 && 
-                 Bit2_get(array, col1 + 1, row1) == 1) {
-                addToStack(p1, col1 + 1, row1);
-                Bit2_put(array, col1 + 1, row1, 0);
-                hasBlackNeighbor = true;
-        }
-        else if (row1 != Bit2_height(array) - 1 && 
-                 Bit2_get(array, col1, row1 + 1) == 1) {
-                addToStack(p1, col1, row1 + 1);
-                Bit2_put(array, col1, row1 + 1, 0);
-                hasBlackNeighbor = true;
-        }
-        return hasBlackNeighbor;
-}
\ No newline at end of file